@@ -0,0 +1,80 @@
+#ifndef _BENCHMARK_ENTITY_H_
+#define _BENCHMARK_ENTITY_H_
+
+#include <StandardDefines.h>
+#include <optional>
+
+// Synthetic entity for the repository benchmarks
+//
+// Hand-rolled Serialize/Deserialize (tab-separated fields, one line) instead
+// of serializationlib annotations, so benchmark numbers measure repository
+// cost rather than the serializer's, and the payload field lets a run dial
+// the record size up or down.
+class BenchmarkRecord {
+    Public int id = 0;
+    Public StdString name;
+    Public double reading = 0.0;
+    Public long timestamp = 0;
+    Public StdString payload;
+
+    Public Static StdString GetTableName() {
+        return StdString("BenchmarkRecord");
+    }
+
+    Public Static StdString GetPrimaryKeyName() {
+        return StdString("id");
+    }
+
+    Public optional<int> GetPrimaryKey() {
+        return id;
+    }
+
+    Public StdString Serialize() {
+        StdString out;
+        out += StdString(std::to_string(id).c_str());
+        out += "\t";
+        out += name;
+        out += "\t";
+        out += StdString(std::to_string(reading).c_str());
+        out += "\t";
+        out += StdString(std::to_string(timestamp).c_str());
+        out += "\t";
+        out += payload;
+        return out;
+    }
+
+    Public Static BenchmarkRecord Deserialize(CStdString& contents) {
+        BenchmarkRecord record;
+        size_t start = 0;
+        int field = 0;
+        for (size_t i = 0; i <= contents.length(); i++) {
+            if (i == contents.length() || contents[i] == '\t') {
+                StdString value = contents.substr(start, i - start);
+                switch (field) {
+                    case 0: record.id = std::stoi(value.c_str()); break;
+                    case 1: record.name = value; break;
+                    case 2: record.reading = std::stod(value.c_str()); break;
+                    case 3: record.timestamp = std::stol(value.c_str()); break;
+                    case 4: record.payload = value; break;
+                    default: break;
+                }
+                field++;
+                start = i + 1;
+            }
+        }
+        return record;
+    }
+
+    // Helper to build a record with a deterministic payload of the given size
+    Public Static BenchmarkRecord Make(int idIn, size_t payloadSize) {
+        BenchmarkRecord record;
+        record.id = idIn;
+        record.name = StdString("record_") + StdString(std::to_string(idIn).c_str());
+        record.reading = idIn * 0.5;
+        record.timestamp = 1700000000L + idIn;
+        record.payload.assign(payloadSize, static_cast<char>('a' + (idIn % 26)));
+        return record;
+    }
+};
+
+#endif // _BENCHMARK_ENTITY_H_
@@ -0,0 +1,203 @@
+// Desktop micro-benchmark suite for CpaRepositoryImpl
+//
+// Exercises the repository end-to-end with synthetic BenchmarkRecord
+// entities: Save throughput, FindById p50/p99 latency, FindAll scan rate,
+// DeleteById cost at varying table sizes, and IDs-file index loading from
+// 1k to 1M rows. Output is one CSV line per measurement on stdout:
+//
+//     benchmark,<phase>,<table_size>,<metric>,<value>,<unit>
+//
+// so a release pipeline can diff runs for regressions. Usage:
+//
+//     repository_benchmark [scale]
+//
+// where scale (default 10000) is the table size used by the CRUD phases;
+// the IDs-scaling phase always runs its 1k/10k/100k/1M ladder.
+
+#include "BenchmarkEntity.h"
+#include <repository/CpaRepositoryImpl.h>
+#include <DesktopFileManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Writable per-run database root derived from TMPDIR (or /tmp)
+static StdString BenchmarkRoot() {
+    const char* tmpDir = std::getenv("TMPDIR");
+    StdString root = tmpDir != nullptr ? tmpDir : "/tmp";
+    if (!root.empty() && root[root.length() - 1] != '/') {
+        root += '/';
+    }
+    root += "springbootplusplus_data_benchmark";
+    return root;
+}
+
+// Nanoseconds elapsed since the given start point
+static long long ElapsedNs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+// Emit one machine-readable result line
+static void Report(const char* phase, size_t tableSize, const char* metric,
+                   double value, const char* unit) {
+    printf("benchmark,%s,%zu,%s,%.3f,%s\n", phase, tableSize, metric, value, unit);
+    fflush(stdout);
+}
+
+// Percentile of a sample vector (sorts it in place)
+static double Percentile(std::vector<long long>& samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1));
+    return static_cast<double>(samples[index]);
+}
+
+// Fresh repository over a fresh DesktopFileManager, pointed at the
+// benchmark's own root instead of the compiled-in DATABASE_PATH
+static std::unique_ptr<CpaRepositoryImpl<BenchmarkRecord, int>> MakeRepository() {
+    auto repository = std::make_unique<CpaRepositoryImpl<BenchmarkRecord, int>>();
+    repository->fileManager = std::make_shared<DesktopFileManager>();
+    StdString root = BenchmarkRoot();
+    repository->SetDatabaseRoot(root);
+    return repository;
+}
+
+// Remove every benchmark table file left behind by a previous phase
+static void CleanTable(size_t maxId) {
+    auto repository = MakeRepository();
+    std::vector<int> ids;
+    ids.reserve(maxId);
+    for (size_t i = 0; i < maxId; i++) {
+        ids.push_back(static_cast<int>(i));
+    }
+    repository->DeleteAllById(ids);
+}
+
+// Phase 1: Save throughput over a growing table
+static void BenchSave(size_t tableSize) {
+    auto repository = MakeRepository();
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < tableSize; i++) {
+        BenchmarkRecord record = BenchmarkRecord::Make(static_cast<int>(i), 64);
+        repository->Save(record);
+    }
+    double seconds = ElapsedNs(start) / 1e9;
+    Report("save", tableSize, "throughput", tableSize / seconds, "ops_per_sec");
+}
+
+// Phase 2: FindById latency distribution over random existing IDs
+static void BenchFindById(size_t tableSize, size_t lookups) {
+    auto repository = MakeRepository();
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(tableSize) - 1);
+
+    std::vector<long long> samples;
+    samples.reserve(lookups);
+    for (size_t i = 0; i < lookups; i++) {
+        int id = pick(rng);
+        Clock::time_point start = Clock::now();
+        optional<BenchmarkRecord> found = repository->FindById(id);
+        samples.push_back(ElapsedNs(start));
+        if (!found.has_value()) {
+            fprintf(stderr, "benchmark error: id %d missing\n", id);
+            exit(1);
+        }
+    }
+    Report("find_by_id", tableSize, "p50_latency", Percentile(samples, 0.50), "ns");
+    Report("find_by_id", tableSize, "p99_latency", Percentile(samples, 0.99), "ns");
+}
+
+// Phase 3: FindAll full-table scan rate
+static void BenchFindAll(size_t tableSize) {
+    auto repository = MakeRepository();
+    Clock::time_point start = Clock::now();
+    StdVector<BenchmarkRecord> all = repository->FindAll();
+    double seconds = ElapsedNs(start) / 1e9;
+    Report("find_all", tableSize, "scan_rate", all.size() / seconds, "entities_per_sec");
+}
+
+// Phase 4: DeleteById average cost at the current table size
+// Deletes a 10% sample so the text IDs-file rewrite cost shows up at scale
+static void BenchDeleteById(size_t tableSize) {
+    auto repository = MakeRepository();
+    size_t deletions = tableSize / 10;
+    if (deletions == 0) {
+        deletions = 1;
+    }
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < deletions; i++) {
+        repository->DeleteById(static_cast<int>(i));
+    }
+    double seconds = ElapsedNs(start) / 1e9;
+    Report("delete_by_id", tableSize, "avg_latency",
+           seconds * 1e9 / deletions, "ns");
+}
+
+// Phase 5: IDs-file scaling: time to load the ID index (Count on a fresh
+// repository) for 1k..1M rows, with the IDs file synthesized directly so
+// the ladder doesn't require writing a million entity files
+static void BenchIdsScaling() {
+    const size_t sizes[] = {1000, 10000, 100000, 1000000};
+    for (size_t rows : sizes) {
+        {
+            // Synthesize the IDs file directly with the repository's own
+            // naming scheme: hash(table + "_IDs") under the benchmark root
+            DesktopFileManager files;
+            StdString contents;
+            for (size_t i = 0; i < rows; i++) {
+                contents += StdString(std::to_string(i).c_str());
+                contents += "\n";
+            }
+            StdString tableKey = BenchmarkRecord::GetTableName() + "_IDs";
+            uint32_t hash = Fnv1a32(tableKey.c_str(), tableKey.length());
+            StdString idsPath = BenchmarkRoot() + "/" + StdString(std::to_string(hash).c_str());
+            files.Create(idsPath, contents);
+        }
+
+        auto repository = MakeRepository();
+        Clock::time_point start = Clock::now();
+        size_t count = repository->Count();
+        double millis = ElapsedNs(start) / 1e6;
+        if (count != rows) {
+            fprintf(stderr, "benchmark error: expected %zu ids, indexed %zu\n", rows, count);
+            exit(1);
+        }
+        Report("ids_index_load", rows, "load_time", millis, "ms");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t scale = 10000;
+    if (argc > 1) {
+        scale = static_cast<size_t>(strtoull(argv[1], nullptr, 10));
+        if (scale == 0) {
+            scale = 10000;
+        }
+    }
+
+    // Create the benchmark's database root before the first phase runs
+    {
+        DesktopFileManager files;
+        StdString root = BenchmarkRoot();
+        files.EnsureDirectory(root);
+    }
+
+    CleanTable(scale);
+    BenchSave(scale);
+    BenchFindById(scale, scale < 10000 ? scale : 10000);
+    BenchFindAll(scale);
+    BenchDeleteById(scale);
+    CleanTable(scale);
+    BenchIdsScaling();
+
+    return 0;
+}
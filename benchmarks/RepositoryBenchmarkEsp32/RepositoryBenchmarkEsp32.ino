@@ -0,0 +1,118 @@
+// ESP32 micro-benchmark sketch for CpaRepositoryImpl
+//
+// On-device counterpart of benchmarks/RepositoryBenchmark.cpp, sized for
+// the Preferences/NVS backend: NVS holds a few hundred KB, so the table
+// sizes are small and the IDs ladder stops at 1k. Results print to Serial
+// in the same CSV shape as the desktop runner:
+//
+//     benchmark,<phase>,<table_size>,<metric>,<value>,<unit>
+//
+// Build as a normal PlatformIO/Arduino sketch with this library installed.
+
+#include <Arduino.h>
+#include <StandardDefines.h>
+#include <repository/CpaRepositoryImpl.h>
+#include <ArduinoFileManager.h>
+#include "../BenchmarkEntity.h"
+
+static CpaRepositoryImpl<BenchmarkRecord, int> repository;
+
+// Emit one machine-readable result line over Serial
+static void Report(const char* phase, size_t tableSize, const char* metric,
+                   double value, const char* unit) {
+    Serial.printf("benchmark,%s,%u,%s,%.3f,%s\n",
+                  phase, static_cast<unsigned>(tableSize), metric, value, unit);
+}
+
+// Percentile of a sorted sample array
+static double Percentile(StdVector<long>& samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1));
+    return static_cast<double>(samples[index]);
+}
+
+static void RunBenchmarks() {
+    const size_t tableSize = 100;
+    const size_t payloadSize = 32;
+
+    // Phase 1: Save throughput
+    unsigned long start = micros();
+    for (size_t i = 0; i < tableSize; i++) {
+        BenchmarkRecord record = BenchmarkRecord::Make(static_cast<int>(i), payloadSize);
+        repository.Save(record);
+    }
+    double seconds = (micros() - start) / 1e6;
+    Report("save", tableSize, "throughput", tableSize / seconds, "ops_per_sec");
+
+    // Phase 2: FindById p50/p99 latency
+    StdVector<long> samples;
+    samples.reserve(tableSize);
+    for (size_t i = 0; i < tableSize; i++) {
+        int id = static_cast<int>((i * 37) % tableSize);
+        unsigned long lookupStart = micros();
+        optional<BenchmarkRecord> found = repository.FindById(id);
+        samples.push_back(static_cast<long>(micros() - lookupStart));
+        if (!found.has_value()) {
+            Serial.printf("benchmark error: id %d missing\n", id);
+            return;
+        }
+    }
+    Report("find_by_id", tableSize, "p50_latency", Percentile(samples, 0.50) * 1000.0, "ns");
+    Report("find_by_id", tableSize, "p99_latency", Percentile(samples, 0.99) * 1000.0, "ns");
+
+    // Phase 3: FindAll scan rate
+    start = micros();
+    StdVector<BenchmarkRecord> all = repository.FindAll();
+    seconds = (micros() - start) / 1e6;
+    Report("find_all", tableSize, "scan_rate", all.size() / seconds, "entities_per_sec");
+
+    // Phase 4: DeleteById average cost (10% sample)
+    size_t deletions = tableSize / 10;
+    start = micros();
+    for (size_t i = 0; i < deletions; i++) {
+        repository.DeleteById(static_cast<int>(i));
+    }
+    seconds = (micros() - start) / 1e6;
+    Report("delete_by_id", tableSize, "avg_latency", seconds * 1e9 / deletions, "ns");
+
+    // Phase 5: IDs index load at 1k rows (NVS-sized ladder)
+    {
+        ArduinoFileManager files;
+        StdString contents;
+        for (size_t i = 0; i < 1000; i++) {
+            contents += StdString(String(i).c_str());
+            contents += "\n";
+        }
+        StdString tableKey = BenchmarkRecord::GetTableName() + "_IDs";
+        uint32_t hash = Fnv1a32(tableKey.c_str(), tableKey.length());
+        StdString idsPath = StdString(String(hash).c_str());
+        files.Create(idsPath, contents);
+
+        CpaRepositoryImpl<BenchmarkRecord, int> freshRepository;
+        freshRepository.fileManager = std::make_shared<ArduinoFileManager>();
+        start = micros();
+        size_t count = freshRepository.Count();
+        double millis = (micros() - start) / 1e3;
+        Report("ids_index_load", count, "load_time", millis, "ms");
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    repository.fileManager = std::make_shared<ArduinoFileManager>();
+    // One NVS session for the whole run; per-call namespace opens would
+    // dominate every measurement otherwise
+    repository.fileManager->BeginSession(false);
+    RunBenchmarks();
+    repository.fileManager->EndSession();
+    Serial.println("benchmark,done,0,complete,1,flag");
+}
+
+void loop() {
+    delay(10000);
+}
@@ -3,6 +3,7 @@
 #define ARDUINO_FILE_MANAGER_H
 
 // #include "IFileManager.h"
+#include "RepositoryStats.h"
 
 // ESP32 Preferences library for reliable storage
 #ifdef ESP32
@@ -12,23 +13,141 @@
 
 /* @Component */
 class ArduinoFileManager final : public IFileManager {
+    #ifdef SPRINGBOOTPLUSPLUS_DATA_STATS
+    private:
+        // Per-method call/byte counters and latency histograms, compiled in
+        // only when SPRINGBOOTPLUSPLUS_DATA_STATS is defined. Update routes
+        // through Create, so its cost shows up under the create counters.
+        FileManagerStats stats;
+
+    public:
+        // Read access to the counters for telemetry export
+        const FileManagerStats& GetStats() const {
+            return stats;
+        }
+
+        // Reset all counters, e.g. at the start of a measurement window
+        void ResetStats() {
+            stats.Reset();
+        }
+    #endif
+
     #ifdef PREFERENCES_AVAILABLE
     private:
         Preferences preferences;
+        // Session mode: between BeginSession and EndSession the Preferences
+        // handle stays open across operations, so a repository Save no longer
+        // pays the NVS namespace open/close three-plus times per call
+        bool sessionActive = false;
+        bool handleOpen = false;
+        bool handleReadOnly = false;
+
+        // Open the Preferences namespace in the requested mode, reusing the
+        // session handle when it is already open in a compatible mode
+        // A read-only handle cannot serve writes and is reopened read-write
+        bool OpenPrefs(bool readOnly) {
+            if (handleOpen) {
+                if (handleReadOnly && !readOnly) {
+                    preferences.end();
+                    handleOpen = false;
+                } else {
+                    return true;
+                }
+            }
+            handleOpen = preferences.begin("filemanager", readOnly);
+            handleReadOnly = readOnly;
+            return handleOpen;
+        }
+
+        // Close the handle unless an active session keeps it open
+        void ClosePrefs() {
+            if (!sessionActive && handleOpen) {
+                preferences.end();
+                handleOpen = false;
+            }
+        }
+
+        // Chunked append mode: a logical file is split across numbered value
+        // chunks ("<name>#0", "<name>#1", ...) plus a "<name>#n" manifest
+        // holding the chunk count, so Append rewrites only the tail chunk.
+        // Appending to an n-entry IDs list otherwise costs O(n) flash writes
+        // and an O(n) RAM spike for the read-concat-write round trip.
+        bool chunkedAppend = false;
+        size_t chunkSizeLimit = 1024; // bytes in a chunk before the next append starts a new one
+
+        // Helper to build the key for one chunk of a logical file
+        StdString ChunkKey(CStdString& filename, uint32_t index) {
+            return filename + StdString("#") + StdString(String(index).c_str());
+        }
+
+        // Helper to build the manifest key holding a logical file's chunk count
+        StdString ManifestKey(CStdString& filename) {
+            return filename + StdString("#n");
+        }
+
+        // Helper to read a logical file's chunk count (0 = not chunked)
+        uint32_t GetChunkCount(CStdString& filename) {
+            return preferences.getUInt(ManifestKey(filename).c_str(), 0);
+        }
+
+        // Helper to remove every chunk and the manifest of a logical file
+        void RemoveChunks(CStdString& filename) {
+            uint32_t count = GetChunkCount(filename);
+            for (uint32_t i = 0; i < count; i++) {
+                preferences.remove(ChunkKey(filename, i).c_str());
+            }
+            if (count > 0) {
+                preferences.remove(ManifestKey(filename).c_str());
+            }
+        }
     #endif
 
     public:
+        // Enable chunked storage for append-heavy keys
+        // chunkSize bounds how large the tail chunk grows before the next
+        // Append starts a fresh chunk; 0 keeps the current limit
+        void SetChunkedAppend(bool enabled, size_t chunkSize = 0) {
+            #ifdef PREFERENCES_AVAILABLE
+                chunkedAppend = enabled;
+                if (chunkSize > 0) {
+                    chunkSizeLimit = chunkSize;
+                }
+            #endif
+        }
+
+        // BeginSession: Keep the Preferences handle open across operations
+        Void BeginSession(Bool readOnly) override {
+            #ifdef PREFERENCES_AVAILABLE
+                sessionActive = true;
+                OpenPrefs(readOnly);
+            #endif
+        }
+
+        // EndSession: Close the handle held open by BeginSession
+        Void EndSession() override {
+            #ifdef PREFERENCES_AVAILABLE
+                sessionActive = false;
+                ClosePrefs();
+            #endif
+        }
+
         // Create: Create a new file with the given filename and contents
         Bool Create(CStdString& filename, CStdString& contents) override {
+            REPOSITORY_STATS_SCOPE(stats.create);
+            REPOSITORY_STATS_BYTES(stats.create, contents.length());
             #ifdef PREFERENCES_AVAILABLE
-                bool result = preferences.begin("filemanager", false);
-                if (!result) {
+                if (!OpenPrefs(false)) {
                     return false;
                 }
-                
+
+                // Create replaces the whole value; drop any chunked representation
+                if (chunkedAppend) {
+                    RemoveChunks(filename);
+                }
+
                 size_t bytesWritten = preferences.putString(filename.c_str(), contents.c_str());
-                preferences.end();
-                
+                ClosePrefs();
+
                 return bytesWritten > 0;
             #else
                 return false;
@@ -37,17 +156,33 @@ class ArduinoFileManager final : public IFileManager {
 
         // Read: Read the contents of a file with the given filename
         StdString Read(CStdString& filename) override {
+            REPOSITORY_STATS_SCOPE(stats.read);
             #ifdef PREFERENCES_AVAILABLE
-                bool result = preferences.begin("filemanager", true); // true = read-only
-                if (!result) {
-                    preferences.end();
+                if (!OpenPrefs(true)) {
+                    ClosePrefs();
                     return StdString("");
                 }
-                
+
+                // Chunked logical files are reassembled from their chunks
+                if (chunkedAppend) {
+                    uint32_t count = GetChunkCount(filename);
+                    if (count > 0) {
+                        StdString content;
+                        for (uint32_t i = 0; i < count; i++) {
+                            String chunk = preferences.getString(ChunkKey(filename, i).c_str(), "");
+                            content += StdString(chunk.c_str());
+                        }
+                        ClosePrefs();
+                        REPOSITORY_STATS_BYTES(stats.read, content.length());
+                        return content;
+                    }
+                }
+
                 String arduinoString = preferences.getString(filename.c_str(), "");
                 StdString content = StdString(arduinoString.c_str());
-                preferences.end();
-                
+                ClosePrefs();
+
+                REPOSITORY_STATS_BYTES(stats.read, content.length());
                 return content;
             #else
                 return StdString("");
@@ -62,15 +197,19 @@ class ArduinoFileManager final : public IFileManager {
 
         // Delete: Delete a file with the given filename
         Bool Delete(CStdString& filename) override {
+            REPOSITORY_STATS_SCOPE(stats.remove);
             #ifdef PREFERENCES_AVAILABLE
-                bool result = preferences.begin("filemanager", false);
-                if (!result) {
+                if (!OpenPrefs(false)) {
                     return false;
                 }
-                
+
+                if (chunkedAppend) {
+                    RemoveChunks(filename);
+                }
+
                 bool deleted = preferences.remove(filename.c_str());
-                preferences.end();
-                
+                ClosePrefs();
+
                 return deleted;
             #else
                 return false;
@@ -79,23 +218,57 @@ class ArduinoFileManager final : public IFileManager {
 
         // Append: Append contents to an existing file (creates file if it doesn't exist)
         Bool Append(CStdString& filename, CStdString& contents) override {
+            REPOSITORY_STATS_SCOPE(stats.append);
+            REPOSITORY_STATS_BYTES(stats.append, contents.length());
             #ifdef PREFERENCES_AVAILABLE
-                bool result = preferences.begin("filemanager", false);
-                if (!result) {
+                if (!OpenPrefs(false)) {
                     return false;
                 }
-                
+
+                if (chunkedAppend) {
+                    // Only the tail chunk is read and rewritten; earlier chunks
+                    // stay untouched on flash
+                    uint32_t count = GetChunkCount(filename);
+
+                    if (count == 0) {
+                        // First chunked append: migrate any existing plain value
+                        // into chunk 0 so the logical contents stay intact
+                        String plain = preferences.getString(filename.c_str(), "");
+                        StdString tail = StdString(plain.c_str()) + contents;
+                        size_t bytesWritten = preferences.putString(ChunkKey(filename, 0).c_str(), tail.c_str());
+                        preferences.putUInt(ManifestKey(filename).c_str(), 1);
+                        if (plain.length() > 0) {
+                            preferences.remove(filename.c_str());
+                        }
+                        ClosePrefs();
+                        return bytesWritten > 0;
+                    }
+
+                    String tailChunk = preferences.getString(ChunkKey(filename, count - 1).c_str(), "");
+                    size_t bytesWritten;
+                    if (tailChunk.length() >= chunkSizeLimit) {
+                        // Tail is full: start a fresh chunk with just the new content
+                        bytesWritten = preferences.putString(ChunkKey(filename, count).c_str(), contents.c_str());
+                        preferences.putUInt(ManifestKey(filename).c_str(), count + 1);
+                    } else {
+                        StdString tail = StdString(tailChunk.c_str()) + contents;
+                        bytesWritten = preferences.putString(ChunkKey(filename, count - 1).c_str(), tail.c_str());
+                    }
+                    ClosePrefs();
+                    return bytesWritten > 0;
+                }
+
                 // Read existing content
                 String arduinoString = preferences.getString(filename.c_str(), "");
                 StdString existingContent = StdString(arduinoString.c_str());
-                
+
                 // Append new content
                 StdString newContent = existingContent + contents;
-                
+
                 // Write back
                 size_t bytesWritten = preferences.putString(filename.c_str(), newContent.c_str());
-                preferences.end();
-                
+                ClosePrefs();
+
                 return bytesWritten > 0;
             #else
                 return false;
@@ -105,4 +278,3 @@ class ArduinoFileManager final : public IFileManager {
 
 #endif // ARDUINO
 #endif // ARDUINO_FILE_MANAGER_H
-
@@ -0,0 +1,249 @@
+#ifndef _COMPRESSING_FILE_MANAGER_H_
+#define _COMPRESSING_FILE_MANAGER_H_
+
+#include "IFileManager.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+DefineStandardPointers(CompressingFileManager)
+// Transparent compression decorator for the IFileManager stack
+//
+// Wraps any IFileManager and compresses contents on Create/Update/Append,
+// decompressing on Read/ReadMapped. Entity payloads (JSON-ish text from
+// serializationlib) typically compress around 4:1, which is flash space and
+// write amplification on ESP32 and smaller I/O everywhere.
+//
+// Stored files start with a 4-byte magic: "SBPZ" for LZ77-compressed data
+// (followed by a varint original length), "SBPR" for data stored raw because
+// compression didn't help. Files with neither magic are legacy uncompressed
+// contents and are returned unchanged, so existing tables keep working.
+//
+// CpaRepositoryImpl takes this through its /* @Autowired */ IFileManagerPtr
+// slot unchanged. The wrapped backend must be binary-safe; DesktopFileManager
+// is, while the Preferences backend in ArduinoFileManager stores values as
+// NUL-terminated strings and cannot carry compressed bytes as-is.
+class CompressingFileManager final : public IFileManager {
+    Private IFileManagerPtr inner;
+
+    Private Static constexpr char COMPRESSED_MAGIC[4] = {'S', 'B', 'P', 'Z'};
+    Private Static constexpr char RAW_MAGIC[4] = {'S', 'B', 'P', 'R'};
+    Private Static constexpr size_t HASH_BITS = 15;
+    Private Static constexpr size_t MIN_MATCH = 4;
+    Private Static constexpr size_t MAX_OFFSET = 65535;
+
+    Public explicit CompressingFileManager(IFileManagerPtr innerIn) : inner(innerIn) {}
+
+    // Helper method to append an unsigned value as a LEB128 varint
+    Private Static Void AppendVarint(StdString& out, size_t value) {
+        while (value >= 0x80) {
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    // Helper method to read a LEB128 varint; returns false on truncation
+    Private Static Bool ReadVarint(const char* data, size_t length, size_t& offset, size_t& value) {
+        value = 0;
+        int shift = 0;
+        while (offset < length) {
+            unsigned char byte = static_cast<unsigned char>(data[offset]);
+            offset++;
+            value |= static_cast<size_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+            shift += 7;
+        }
+        return false;
+    }
+
+    // Helper method to hash a 4-byte prefix into the match table
+    Private Static uint32_t Hash4(const char* data) {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return (value * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // Helper method to compress contents with a greedy LZ77 pass
+    // Output stream is a sequence of [literal-run][match] tokens:
+    //   varint literal length, literal bytes,
+    //   varint match length (0 terminates), varint match offset
+    Protected Static StdString Compress(CStdString& input) {
+        const char* data = input.c_str();
+        size_t n = input.length();
+
+        StdString out;
+        out.append(COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC));
+        AppendVarint(out, n);
+
+        std::vector<int32_t> table(static_cast<size_t>(1) << HASH_BITS, -1);
+        size_t i = 0;
+        size_t literalStart = 0;
+
+        while (i + MIN_MATCH <= n) {
+            uint32_t h = Hash4(data + i);
+            int32_t candidate = table[h];
+            table[h] = static_cast<int32_t>(i);
+
+            if (candidate >= 0 &&
+                i - static_cast<size_t>(candidate) <= MAX_OFFSET &&
+                memcmp(data + candidate, data + i, MIN_MATCH) == 0) {
+                size_t matchLength = MIN_MATCH;
+                while (i + matchLength < n &&
+                       data[candidate + matchLength] == data[i + matchLength]) {
+                    matchLength++;
+                }
+
+                AppendVarint(out, i - literalStart);
+                out.append(data + literalStart, i - literalStart);
+                AppendVarint(out, matchLength);
+                AppendVarint(out, i - static_cast<size_t>(candidate));
+
+                i += matchLength;
+                literalStart = i;
+            } else {
+                i++;
+            }
+        }
+
+        // Trailing literal run; match length 0 ends the stream
+        AppendVarint(out, n - literalStart);
+        out.append(data + literalStart, n - literalStart);
+        AppendVarint(out, 0);
+
+        // Incompressible data is stored raw behind its own magic
+        if (out.length() >= n + sizeof(RAW_MAGIC)) {
+            StdString raw;
+            raw.append(RAW_MAGIC, sizeof(RAW_MAGIC));
+            raw.append(data, n);
+            return raw;
+        }
+        return out;
+    }
+
+    // Helper method to decompress stored contents
+    // Legacy files without a magic header pass through unchanged
+    Protected Static StdString Decompress(CStdString& stored) {
+        const char* data = stored.c_str();
+        size_t length = stored.length();
+
+        if (length >= sizeof(RAW_MAGIC) &&
+            memcmp(data, RAW_MAGIC, sizeof(RAW_MAGIC)) == 0) {
+            return StdString(data + sizeof(RAW_MAGIC), length - sizeof(RAW_MAGIC));
+        }
+        if (length < sizeof(COMPRESSED_MAGIC) ||
+            memcmp(data, COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC)) != 0) {
+            return stored; // legacy uncompressed file
+        }
+
+        size_t offset = sizeof(COMPRESSED_MAGIC);
+        size_t originalLength;
+        if (!ReadVarint(data, length, offset, originalLength)) {
+            return StdString("");
+        }
+
+        StdString out;
+        out.reserve(originalLength);
+
+        for (;;) {
+            size_t literalLength;
+            if (!ReadVarint(data, length, offset, literalLength) ||
+                offset + literalLength > length) {
+                break; // truncated stream
+            }
+            out.append(data + offset, literalLength);
+            offset += literalLength;
+
+            size_t matchLength;
+            if (!ReadVarint(data, length, offset, matchLength)) {
+                break;
+            }
+            if (matchLength == 0) {
+                break; // end of stream
+            }
+
+            size_t matchOffset;
+            if (!ReadVarint(data, length, offset, matchOffset) ||
+                matchOffset == 0 || matchOffset > out.length()) {
+                break;
+            }
+            // Byte-by-byte copy: matches may overlap their own output
+            size_t from = out.length() - matchOffset;
+            for (size_t j = 0; j < matchLength; j++) {
+                out += out[from + j];
+            }
+        }
+
+        return out;
+    }
+
+    // Create: Compress and create the file through the wrapped manager
+    Public Bool Create(CStdString& filename, CStdString& contents) override {
+        StdString compressed = Compress(contents);
+        CStdString compressedRef = compressed;
+        return inner->Create(filename, compressedRef);
+    }
+
+    // Read: Read through the wrapped manager and decompress
+    Public StdString Read(CStdString& filename) override {
+        StdString stored = inner->Read(filename);
+        if (stored.empty()) {
+            return stored;
+        }
+        CStdString storedRef = stored;
+        return Decompress(storedRef);
+    }
+
+    // CreateAtomic: Compress and commit atomically through the wrapped manager
+    Public Bool CreateAtomic(CStdString& filename, CStdString& contents) override {
+        StdString compressed = Compress(contents);
+        return inner->CreateAtomic(filename, compressed);
+    }
+
+    // Update: Compress and update the file through the wrapped manager
+    Public Bool Update(CStdString& filename, CStdString& contents) override {
+        StdString compressed = Compress(contents);
+        CStdString compressedRef = compressed;
+        return inner->Update(filename, compressedRef);
+    }
+
+    // Delete: Delete through the wrapped manager
+    Public Bool Delete(CStdString& filename) override {
+        return inner->Delete(filename);
+    }
+
+    // Append: Appending into a compressed stream requires recompressing the
+    // logical contents, so this reads, concatenates and rewrites
+    Public Bool Append(CStdString& filename, CStdString& contents) override {
+        StdString combined = Read(filename) + contents;
+        CStdString combinedRef = combined;
+        return Create(filename, combinedRef);
+    }
+
+    // EnsureDirectory: Directories are the wrapped backend's concern
+    // Inheriting the no-op default would swallow the call and leave the
+    // sharded layout without its table and bucket directories
+    Public Bool EnsureDirectory(CStdString& path) override {
+        return inner->EnsureDirectory(path);
+    }
+
+    // ReadMapped: Decompressed contents live in an owned buffer
+    // (a zero-copy view into compressed bytes would not be usable)
+    Public FileMappingPtr ReadMapped(CStdString& filename) override {
+        return std::make_shared<BufferedFileMapping>(Read(filename));
+    }
+
+    // BeginSession / EndSession: Forward the lifecycle to the wrapped manager
+    Public Void BeginSession(Bool readOnly) override {
+        inner->BeginSession(readOnly);
+    }
+
+    Public Void EndSession() override {
+        inner->EndSession();
+    }
+};
+
+#endif // _COMPRESSING_FILE_MANAGER_H_
@@ -2,6 +2,8 @@
 #define _JPA_REPOSITORY_H_
 
 #include <StandardDefines.h>
+#include <functional>
+#include <utility>
 
 template<typename Entity, typename ID>
 class CpaRepository {
@@ -10,18 +12,56 @@ class CpaRepository {
     // Create: Save a new entity
     Public Virtual Entity Save(Entity& entity) = 0;
 
+    // Create: Save a new entity passed as an rvalue; moves it back out
+    // Default forwards to the lvalue overload; implementations override it
+    // when they can avoid the forwarded call's return copy entirely
+    Public Virtual Entity Save(Entity&& entity) {
+        Save(entity);
+        return std::move(entity);
+    }
+
+    // Create: Save a batch of entities with a single IDs-file commit
+    Public Virtual StdVector<Entity> SaveAll(StdVector<Entity>& entities) = 0;
+
     // Read: Find entity by ID
     Public Virtual optional<Entity> FindById(ID id) = 0;
 
     // Read: Find all entities
     Public Virtual StdVector<Entity> FindAll() = 0;
 
+    // Read: Stream all entities one at a time through a callback
+    // The callback returns false to stop iteration early
+    Public Virtual Void ForEach(std::function<Bool(Entity&)> callback) = 0;
+
+    // Read: Find one page of entities (pageNumber is zero-based)
+    Public Virtual StdVector<Entity> FindAll(size_t pageNumber, size_t pageSize) = 0;
+
+    // Read: Find all entities ordered by primary key
+    Public Virtual StdVector<Entity> FindAllSorted(Bool ascending) = 0;
+
+    // Read: Find the first K entities in primary-key order
+    // Sorts only the lightweight ID list, then deserializes K entities,
+    // so "latest 100" costs O(K) reads instead of a full materialized sort
+    Public Virtual StdVector<Entity> FindTopK(size_t k, Bool ascending) = 0;
+
+    // Count: Number of entities in the table
+    Public Virtual size_t Count() = 0;
+
     // Update: Update an existing entity
     Public Virtual Entity Update(Entity& entity) = 0;
 
+    // Update: Update an existing entity passed as an rvalue; moves it back out
+    Public Virtual Entity Update(Entity&& entity) {
+        Update(entity);
+        return std::move(entity);
+    }
+
     // Delete: Delete entity by ID
     Public Virtual Void DeleteById(ID id) = 0;
 
+    // Delete: Delete a batch of entities by ID with a single IDs-file commit
+    Public Virtual Void DeleteAllById(const StdVector<ID>& ids) = 0;
+
     // Delete: Delete an entity
     Public Virtual Void Delete(Entity& entity) = 0;
 
@@ -4,54 +4,136 @@
 #define DESKTOP_FILE_MANAGER
 
 #include "IFileManager.h"
+#include "RepositoryStats.h"
+#include <cerrno>
 #include <fstream>
 #include <iostream>
+#include <memory>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Memory-mapped view over a file's contents (mmap-backed)
+// The mapping stays valid until this object is destroyed; the OS page cache
+// serves repeated scans without copying the file into the heap
+class MappedFileMapping final : public FileMapping {
+    Private const char* data = nullptr;
+    Private size_t length = 0;
+
+    Public MappedFileMapping(const char* dataIn, size_t lengthIn) : data(dataIn), length(lengthIn) {}
+
+    Public ~MappedFileMapping() override {
+        if (data != nullptr && length > 0) {
+            munmap(const_cast<char*>(data), length);
+        }
+    }
+
+    Public const char* Data() const override { return data; }
+
+    Public size_t Length() const override { return length; }
+};
 
 /* @Component */
 class DesktopFileManager final : public IFileManager {
+#ifdef SPRINGBOOTPLUSPLUS_DATA_STATS
+    // Per-method call/byte counters and latency histograms, compiled in
+    // only when SPRINGBOOTPLUSPLUS_DATA_STATS is defined
+    Private FileManagerStats stats;
+
+    // Read access to the counters for telemetry export
+    Public const FileManagerStats& GetStats() const {
+        return stats;
+    }
+
+    // Reset all counters, e.g. at the start of a measurement window
+    Public Void ResetStats() {
+        stats.Reset();
+    }
+#endif
+
     // Create: Create a new file with the given filename and contents
+    // Writes the full byte range so binary payloads (compressed or binary
+    // serialized contents) survive embedded NUL bytes
     Public Bool Create(CStdString& filename, CStdString& contents) override {
-        std::ofstream file(filename.c_str(), std::ios::out | std::ios::trunc);
+        REPOSITORY_STATS_SCOPE(stats.create);
+        REPOSITORY_STATS_BYTES(stats.create, contents.length());
+        std::ofstream file(filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
         if (!file.is_open()) {
             return false;
         }
-        file << contents.c_str();
+        file.write(contents.c_str(), contents.length());
         file.close();
         return true;
     }
 
     // Read: Read the contents of a file with the given filename
+    // Reads the exact bytes in one bulk operation instead of line-by-line
+    // concatenation, preserving binary payloads
     Public StdString Read(CStdString& filename) override {
-        std::ifstream file(filename.c_str(), std::ios::in);
+        REPOSITORY_STATS_SCOPE(stats.read);
+        std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
         if (!file.is_open()) {
             return StdString("");
         }
-        
-        StdString contents;
-        std::string line;
-        while (std::getline(file, line)) {
-            contents += StdString(line.c_str());
-            if (!file.eof()) {
-                contents += StdString("\n");
-            }
+
+        file.seekg(0, std::ios::end);
+        std::streampos size = file.tellg();
+        if (size <= 0) {
+            file.close();
+            return StdString("");
         }
+        file.seekg(0, std::ios::beg);
+
+        StdString contents(static_cast<size_t>(size), '\0');
+        file.read(&contents[0], size);
         file.close();
+        REPOSITORY_STATS_BYTES(stats.read, contents.length());
         return contents;
     }
 
+    // ReadInto: Read the exact bytes into the caller's buffer
+    // resize keeps the buffer's existing capacity, so a scan loop passing
+    // the same string reaches zero steady-state allocations
+    Public Void ReadInto(CStdString& filename, StdString& contents) override {
+        REPOSITORY_STATS_SCOPE(stats.read);
+        contents.clear();
+        std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            return;
+        }
+
+        file.seekg(0, std::ios::end);
+        std::streampos size = file.tellg();
+        if (size <= 0) {
+            file.close();
+            return;
+        }
+        file.seekg(0, std::ios::beg);
+
+        contents.resize(static_cast<size_t>(size));
+        file.read(&contents[0], size);
+        file.close();
+        REPOSITORY_STATS_BYTES(stats.read, contents.length());
+    }
+
     // Update: Update an existing file with the given filename and new contents
     Public Bool Update(CStdString& filename, CStdString& contents) override {
-        std::ofstream file(filename.c_str(), std::ios::out | std::ios::trunc);
+        REPOSITORY_STATS_SCOPE(stats.update);
+        REPOSITORY_STATS_BYTES(stats.update, contents.length());
+        std::ofstream file(filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
         if (!file.is_open()) {
             return false;
         }
-        file << contents.c_str();
+        file.write(contents.c_str(), contents.length());
         file.close();
         return true;
     }
 
     // Delete: Delete a file with the given filename
     Public Bool Delete(CStdString& filename) override {
+        REPOSITORY_STATS_SCOPE(stats.remove);
         if (std::remove(filename.c_str()) == 0) {
             return true;
         }
@@ -60,15 +142,83 @@ class DesktopFileManager final : public IFileManager {
 
     // Append: Append contents to an existing file (creates file if it doesn't exist)
     Public Bool Append(CStdString& filename, CStdString& contents) override {
-        std::ofstream file(filename.c_str(), std::ios::out | std::ios::app);
+        REPOSITORY_STATS_SCOPE(stats.append);
+        REPOSITORY_STATS_BYTES(stats.append, contents.length());
+        std::ofstream file(filename.c_str(), std::ios::out | std::ios::app | std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(contents.c_str(), contents.length());
+        file.close();
+        return true;
+    }
+
+    // CreateAtomic: Write to a temp file, then rename it over the target
+    // rename(2) is atomic on POSIX filesystems, so a crash mid-write leaves
+    // the old contents intact instead of a truncated file
+    Public Bool CreateAtomic(CStdString& filename, CStdString& contents) override {
+        StdString tempPath = filename + ".tmp";
+        std::ofstream file(tempPath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
         if (!file.is_open()) {
             return false;
         }
-        file << contents.c_str();
+        file.write(contents.c_str(), contents.length());
         file.close();
+        if (!file.good()) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+        return std::rename(tempPath.c_str(), filename.c_str()) == 0;
+    }
+
+    // EnsureDirectory: Create the directory and any missing parents
+    // mkdir(2) on an existing directory is a cheap EEXIST, so calling this
+    // repeatedly costs one syscall per path component
+    Public Bool EnsureDirectory(CStdString& path) override {
+        size_t position = 0;
+        while (position < path.length()) {
+            size_t separator = path.find('/', position);
+            if (separator == StdString::npos) {
+                separator = path.length();
+            }
+            if (separator > 0) {
+                StdString component = path.substr(0, separator);
+                if (mkdir(component.c_str(), 0755) != 0 && errno != EEXIST) {
+                    return false;
+                }
+            }
+            position = separator + 1;
+        }
         return true;
     }
 
+    // ReadMapped: Read a file as a zero-copy memory-mapped view
+    // Falls back to an empty buffered mapping when the file is missing or empty
+    Public FileMappingPtr ReadMapped(CStdString& filename) override {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return std::make_shared<BufferedFileMapping>(StdString(""));
+        }
+
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0) {
+            close(fd);
+            return std::make_shared<BufferedFileMapping>(StdString(""));
+        }
+
+        size_t length = static_cast<size_t>(fileInfo.st_size);
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file; the descriptor can go
+        close(fd);
+
+        if (mapped == MAP_FAILED) {
+            // mmap can fail on exotic filesystems; fall back to a buffered read
+            return std::make_shared<BufferedFileMapping>(Read(filename));
+        }
+
+        return std::make_shared<MappedFileMapping>(static_cast<const char*>(mapped), length);
+    }
+
 };
 
 #endif // ARDUINO
@@ -0,0 +1,37 @@
+#ifndef _FILE_MAPPING_H_
+#define _FILE_MAPPING_H_
+
+#include <StandardDefines.h>
+#include <memory>
+
+DefineStandardPointers(FileMapping)
+// Zero-copy view over a file's contents
+// Implementations keep the underlying storage (memory mapping or owned
+// buffer) alive for the lifetime of the object, so Data()/Length() stay
+// valid until the mapping is destroyed
+class FileMapping {
+    Public Virtual ~FileMapping() = default;
+
+    // Data: Pointer to the first byte of the file contents
+    Public Virtual const char* Data() const = 0;
+
+    // Length: Number of bytes in the file contents
+    Public Virtual size_t Length() const = 0;
+
+    // Empty: Check if the mapping holds no contents (missing or empty file)
+    Public Bool Empty() const { return Length() == 0; }
+};
+
+// Fallback mapping that owns a buffered copy of the contents
+// Used wherever a real memory mapping is unavailable (Arduino, read errors)
+class BufferedFileMapping final : public FileMapping {
+    Private StdString contents;
+
+    Public explicit BufferedFileMapping(const StdString& contentsIn) : contents(contentsIn) {}
+
+    Public const char* Data() const override { return contents.c_str(); }
+
+    Public size_t Length() const override { return contents.length(); }
+};
+
+#endif // _FILE_MAPPING_H_
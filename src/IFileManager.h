@@ -2,6 +2,7 @@
 #define _IFILEMANAGER_H_
 
 #include <StandardDefines.h>
+#include "FileMapping.h"
 
 DefineStandardPointers(IFileManager)
 class IFileManager {
@@ -21,6 +22,46 @@ class IFileManager {
 
     // Append: Append contents to an existing file (creates file if it doesn't exist)
     Public Virtual Bool Append(CStdString& filename, CStdString& contents) = 0;
+
+    // CreateAtomic: Create or replace a file so readers see either the old
+    // contents or the new, never a partial write. Backends with rename
+    // support override this (see DesktopFileManager); key-value backends
+    // like ESP32 Preferences replace values atomically already, so the
+    // default plain Create is the correct behavior there
+    Public Virtual Bool CreateAtomic(CStdString& filename, CStdString& contents) {
+        return Create(filename, contents);
+    }
+
+    // EnsureDirectory: Make sure a directory exists, creating it and any
+    // missing parents where the backend has real directories. Key-value
+    // backends (e.g. ESP32 Preferences) have no directory tree, so the
+    // default succeeds as a no-op
+    Public Virtual Bool EnsureDirectory(CStdString& path) {
+        return true;
+    }
+
+    // ReadInto: Read a file's contents into a caller-owned buffer
+    // The default delegates to Read; backends that can fill the buffer in
+    // place override it so scan loops recycle one buffer's capacity instead
+    // of allocating a fresh string per file
+    Public Virtual Void ReadInto(CStdString& filename, StdString& contents) {
+        contents = Read(filename);
+    }
+
+    // ReadMapped: Read a file as a zero-copy view of its contents
+    // Platforms with memory mapping override this (see DesktopFileManager);
+    // the default implementation falls back to a buffered Read
+    Public Virtual FileMappingPtr ReadMapped(CStdString& filename) {
+        return std::make_shared<BufferedFileMapping>(Read(filename));
+    }
+
+    // BeginSession: Open an I/O session spanning multiple operations
+    // Backends whose storage handle is costly to open per call (e.g. ESP32
+    // Preferences/NVS) keep it open until EndSession; others ignore this
+    Public Virtual Void BeginSession(Bool readOnly) {}
+
+    // EndSession: Close the I/O session opened by BeginSession
+    Public Virtual Void EndSession() {}
 };
 
 #endif // _IFILEMANAGER_H_
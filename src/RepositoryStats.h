@@ -0,0 +1,166 @@
+#ifndef _REPOSITORY_STATS_H_
+#define _REPOSITORY_STATS_H_
+
+#include <StandardDefines.h>
+#include <cstdint>
+
+#ifdef SPRINGBOOTPLUSPLUS_DATA_STATS
+#ifndef ARDUINO
+#include <chrono>
+#endif
+#endif
+
+// Optional hot-path instrumentation, compiled in only when
+// SPRINGBOOTPLUSPLUS_DATA_STATS is defined. Each instrumented method keeps a
+// call counter, a bytes-moved counter and a coarse power-of-two latency
+// histogram (bucket i covers [2^i, 2^(i+1)) microseconds), cheap enough to
+// leave on in field builds that need it. Without the flag the recording
+// macros expand to nothing and no members exist, so the uninstrumented
+// build pays zero cost in either cycles or RAM.
+#ifdef SPRINGBOOTPLUSPLUS_DATA_STATS
+
+// Microsecond timestamp from the platform's monotonic source
+inline uint64_t StatsNowMicros() {
+#ifdef ARDUINO
+    return static_cast<uint64_t>(micros());
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Counters and latency histogram for one instrumented operation
+struct OperationStats {
+    Static constexpr size_t LATENCY_BUCKET_COUNT = 16;
+
+    uint64_t calls = 0;
+    uint64_t bytes = 0;
+    uint64_t totalMicros = 0;
+    uint64_t latencyBuckets[LATENCY_BUCKET_COUNT] = {0};
+
+    // Record one completed call of the given duration
+    Void RecordCall(uint64_t durationMicros) {
+        calls++;
+        totalMicros += durationMicros;
+        size_t bucket = 0;
+        while (bucket + 1 < LATENCY_BUCKET_COUNT && (durationMicros >> (bucket + 1)) != 0) {
+            bucket++;
+        }
+        latencyBuckets[bucket]++;
+    }
+
+    // Record bytes moved by the current call
+    Void RecordBytes(size_t byteCount) {
+        bytes += byteCount;
+    }
+
+    Void Reset() {
+        calls = 0;
+        bytes = 0;
+        totalMicros = 0;
+        for (size_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+            latencyBuckets[i] = 0;
+        }
+    }
+
+    // Append one telemetry line: <name>,calls,bytes,avg_us,b0,b1,...
+    Void AppendReport(StdString& out, const char* name) const {
+        out += name;
+        out += ",";
+        out += StdString(std::to_string(calls).c_str());
+        out += ",";
+        out += StdString(std::to_string(bytes).c_str());
+        out += ",";
+        uint64_t average = calls > 0 ? totalMicros / calls : 0;
+        out += StdString(std::to_string(average).c_str());
+        for (size_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+            out += ",";
+            out += StdString(std::to_string(latencyBuckets[i]).c_str());
+        }
+        out += "\n";
+    }
+};
+
+// RAII timer attributing its scope's duration to one OperationStats
+struct ScopedStatsTimer {
+    OperationStats& stats;
+    uint64_t startMicros;
+
+    explicit ScopedStatsTimer(OperationStats& statsIn)
+        : stats(statsIn), startMicros(StatsNowMicros()) {}
+
+    ~ScopedStatsTimer() {
+        stats.RecordCall(StatsNowMicros() - startMicros);
+    }
+};
+
+// Per-method stats for an IFileManager implementation
+struct FileManagerStats {
+    OperationStats create;
+    OperationStats read;
+    OperationStats update;
+    OperationStats remove;
+    OperationStats append;
+
+    Void Reset() {
+        create.Reset();
+        read.Reset();
+        update.Reset();
+        remove.Reset();
+        append.Reset();
+    }
+
+    StdString Report() const {
+        StdString out;
+        create.AppendReport(out, "filemanager.create");
+        read.AppendReport(out, "filemanager.read");
+        update.AppendReport(out, "filemanager.update");
+        remove.AppendReport(out, "filemanager.delete");
+        append.AppendReport(out, "filemanager.append");
+        return out;
+    }
+};
+
+// Per-operation stats for CpaRepositoryImpl
+struct RepositoryStats {
+    OperationStats save;
+    OperationStats findById;
+    OperationStats findAll;
+    OperationStats update;
+    OperationStats deleteById;
+    OperationStats idsLoad;
+
+    Void Reset() {
+        save.Reset();
+        findById.Reset();
+        findAll.Reset();
+        update.Reset();
+        deleteById.Reset();
+        idsLoad.Reset();
+    }
+
+    StdString Report() const {
+        StdString out;
+        save.AppendReport(out, "repository.save");
+        findById.AppendReport(out, "repository.find_by_id");
+        findAll.AppendReport(out, "repository.find_all");
+        update.AppendReport(out, "repository.update");
+        deleteById.AppendReport(out, "repository.delete_by_id");
+        idsLoad.AppendReport(out, "repository.ids_load");
+        return out;
+    }
+};
+
+// Recording macros used by the instrumented classes
+#define REPOSITORY_STATS_SCOPE(operation) ScopedStatsTimer repositoryStatsTimer(operation)
+#define REPOSITORY_STATS_BYTES(operation, byteCount) (operation).RecordBytes(byteCount)
+
+#else // SPRINGBOOTPLUSPLUS_DATA_STATS
+
+// Uninstrumented build: recording sites compile to nothing
+#define REPOSITORY_STATS_SCOPE(operation)
+#define REPOSITORY_STATS_BYTES(operation, byteCount)
+
+#endif // SPRINGBOOTPLUSPLUS_DATA_STATS
+
+#endif // _REPOSITORY_STATS_H_
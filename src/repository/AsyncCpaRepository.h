@@ -0,0 +1,175 @@
+#ifndef ARDUINO
+
+#ifndef _ASYNC_CPA_REPOSITORY_H_
+#define _ASYNC_CPA_REPOSITORY_H_
+
+#include "../CpaRepository.h"
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <vector>
+
+// Asynchronous companion to CpaRepository (desktop only)
+//
+// Every CpaRepository method is synchronous, so callers block for the full
+// disk round-trip. This wrapper hands each operation to a small worker pool
+// and returns a std::future immediately, so HTTP threads keep serving while
+// the I/O happens off-thread.
+//
+// Ordering: operations are dispatched to a worker chosen by ID hash, and each
+// worker runs its queue in FIFO order, so operations on the same ID execute
+// in submission order. Operations on different IDs may interleave. Whole-table
+// operations (FindAllAsync, SaveAllAsync, ForEach-style work) run on worker 0.
+//
+// With more than one worker the underlying repository sees concurrent calls
+// on different IDs; pair it with CpaRepositoryImpl::SetThreadSafe(true), or
+// construct the pool with workerCount 1 for strictly serial execution.
+template<typename Entity, typename ID>
+class AsyncCpaRepository {
+    Private struct Worker {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wakeup;
+        std::deque<std::function<void()>> tasks;
+        Bool stopping = false;
+    };
+
+    Private std::shared_ptr<CpaRepository<Entity, ID>> repository;
+    Private std::vector<std::unique_ptr<Worker>> workers;
+
+    Public explicit AsyncCpaRepository(std::shared_ptr<CpaRepository<Entity, ID>> repositoryIn,
+                                       size_t workerCount = 4)
+        : repository(repositoryIn) {
+        if (workerCount == 0) {
+            workerCount = 1;
+        }
+        for (size_t i = 0; i < workerCount; i++) {
+            workers.push_back(std::make_unique<Worker>());
+            Worker* worker = workers.back().get();
+            worker->thread = std::thread([worker]() {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(worker->mutex);
+                        worker->wakeup.wait(lock, [worker]() {
+                            return worker->stopping || !worker->tasks.empty();
+                        });
+                        if (worker->tasks.empty()) {
+                            return; // stopping and drained
+                        }
+                        task = worker->tasks.front();
+                        worker->tasks.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    // Drains every worker queue before joining, so all submitted operations
+    // complete and their futures become ready
+    Public ~AsyncCpaRepository() {
+        for (auto& worker : workers) {
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                worker->stopping = true;
+            }
+            worker->wakeup.notify_all();
+        }
+        for (auto& worker : workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+    }
+
+    // Helper method to enqueue a task on the worker owning the given ID
+    Private template<typename Result>
+    std::future<Result> Submit(size_t workerIndex, std::function<Result()> work) {
+        auto task = std::make_shared<std::packaged_task<Result()>>(work);
+        std::future<Result> result = task->get_future();
+        Worker* worker = workers[workerIndex].get();
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->tasks.push_back([task]() { (*task)(); });
+        }
+        worker->wakeup.notify_one();
+        return result;
+    }
+
+    // Helper method to pick the worker for an ID (per-ID FIFO ordering)
+    Private size_t WorkerFor(ID id) {
+        return std::hash<ID>{}(id) % workers.size();
+    }
+
+    // Create: Save a new entity off-thread
+    // The entity is copied into the task; the future yields the saved entity
+    Public std::future<Entity> SaveAsync(Entity entity) {
+        optional<ID> id = entity.GetPrimaryKey();
+        size_t workerIndex = id.has_value() ? WorkerFor(id.value()) : 0;
+        auto repo = repository;
+        return Submit<Entity>(workerIndex, [repo, entity]() mutable -> Entity {
+            return repo->Save(entity);
+        });
+    }
+
+    // Create: Save a batch of entities off-thread (runs on worker 0)
+    Public std::future<StdVector<Entity>> SaveAllAsync(StdVector<Entity> entities) {
+        auto repo = repository;
+        return Submit<StdVector<Entity>>(0, [repo, entities]() mutable -> StdVector<Entity> {
+            return repo->SaveAll(entities);
+        });
+    }
+
+    // Read: Find entity by ID off-thread
+    Public std::future<optional<Entity>> FindByIdAsync(ID id) {
+        auto repo = repository;
+        return Submit<optional<Entity>>(WorkerFor(id), [repo, id]() -> optional<Entity> {
+            return repo->FindById(id);
+        });
+    }
+
+    // Read: Find all entities off-thread (runs on worker 0)
+    Public std::future<StdVector<Entity>> FindAllAsync() {
+        auto repo = repository;
+        return Submit<StdVector<Entity>>(0, [repo]() -> StdVector<Entity> {
+            return repo->FindAll();
+        });
+    }
+
+    // Update: Update an existing entity off-thread
+    Public std::future<Entity> UpdateAsync(Entity entity) {
+        optional<ID> id = entity.GetPrimaryKey();
+        size_t workerIndex = id.has_value() ? WorkerFor(id.value()) : 0;
+        auto repo = repository;
+        return Submit<Entity>(workerIndex, [repo, entity]() mutable -> Entity {
+            return repo->Update(entity);
+        });
+    }
+
+    // Delete: Delete entity by ID off-thread
+    // The future becomes ready once the delete has been committed
+    Public std::future<Bool> DeleteByIdAsync(ID id) {
+        auto repo = repository;
+        return Submit<Bool>(WorkerFor(id), [repo, id]() -> Bool {
+            repo->DeleteById(id);
+            return true;
+        });
+    }
+
+    // Check if entity exists by ID off-thread
+    Public std::future<Bool> ExistsByIdAsync(ID id) {
+        auto repo = repository;
+        return Submit<Bool>(WorkerFor(id), [repo, id]() -> Bool {
+            return repo->ExistsById(id);
+        });
+    }
+};
+
+#endif // _ASYNC_CPA_REPOSITORY_H_
+
+#endif // ARDUINO
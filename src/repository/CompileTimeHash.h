@@ -0,0 +1,35 @@
+#ifndef _COMPILE_TIME_HASH_H_
+#define _COMPILE_TIME_HASH_H_
+
+#include <cstdint>
+#include <cstddef>
+
+// Compile-time FNV-1a hashing for table-derived file names
+//
+// std::hash is implementation-defined, so hashed file names differed between
+// desktop and ESP32 builds and could never be computed at compile time.
+// FNV-1a is deterministic across platforms and constexpr, so hash inputs that
+// are known during compilation (string literals, fixed table/key names) fold
+// into constants instead of hashing ~1KB of string churn per operation.
+
+// FNV-1a 32-bit parameters
+constexpr uint32_t FNV1A_32_OFFSET_BASIS = 2166136261u;
+constexpr uint32_t FNV1A_32_PRIME = 16777619u;
+
+// Hash a byte range with FNV-1a (usable at compile time and at runtime)
+constexpr uint32_t Fnv1a32(const char* data, size_t length) {
+    uint32_t hash = FNV1A_32_OFFSET_BASIS;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint32_t>(static_cast<unsigned char>(data[i]));
+        hash *= FNV1A_32_PRIME;
+    }
+    return hash;
+}
+
+// Hash a string literal with FNV-1a at compile time
+template<size_t N>
+constexpr uint32_t Fnv1a32(const char (&literal)[N]) {
+    return Fnv1a32(literal, N - 1); // exclude the terminating NUL
+}
+
+#endif // _COMPILE_TIME_HASH_H_
@@ -3,11 +3,30 @@
 
 #include "../CpaRepository.h"
 #include "../IFileManager.h"
+#include "../RepositoryStats.h"
+#include "CompileTimeHash.h"
+#include "FastIdScan.h"
 #include <optional>
 #include <type_traits>
 #include <functional>
 #include <cstdint>
+#include <unordered_set>
+#include <unordered_map>
+#include <list>
+#include <cstring>
+#include <cstdio>
+#include <utility>
+#include <algorithm>
 
+#ifndef ARDUINO
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+#endif
+
+// Compile-time default for the database root; each repository instance can
+// be pointed elsewhere at runtime with SetDatabaseRoot
 #ifdef ARDUINO
 #define DATABASE_PATH ""
 #else
@@ -16,11 +35,120 @@
 
 template<typename Entity, typename ID>
 class CpaRepositoryImpl : public CpaRepository<Entity, ID> {
-    Public Virtual ~CpaRepositoryImpl() = default;
+    Public Virtual ~CpaRepositoryImpl() {
+#ifndef ARDUINO
+        // A background snapshot verifier must not outlive the repository
+        if (snapshotVerifier.joinable()) {
+            snapshotVerifier.join();
+        }
+#endif
+    }
 
     /* @Autowired */
     IFileManagerPtr fileManager;
 
+#ifdef SPRINGBOOTPLUSPLUS_DATA_STATS
+    // Hot-path instrumentation (see RepositoryStats.h): per-operation call
+    // counters, bytes moved and latency histograms, compiled in only when
+    // SPRINGBOOTPLUSPLUS_DATA_STATS is defined
+    Private RepositoryStats stats;
+
+    // Read access to the counters for telemetry export
+    Public const RepositoryStats& GetStats() const {
+        return stats;
+    }
+
+    // Reset all counters, e.g. at the start of a measurement window
+    Public Void ResetStats() {
+        stats.Reset();
+    }
+#endif
+
+#ifndef ARDUINO
+    // Concurrency-safe mode (desktop only), off by default so single-threaded
+    // users pay nothing. Entity operations take a reader-writer lock from a
+    // stripe keyed by ID hash, so FindById calls on different entities run
+    // fully parallel; the ID index, caches and secondary indexes are guarded
+    // by their own short locks inside the respective helpers.
+    Private Bool threadSafe = false;
+    Private Static constexpr size_t LOCK_STRIPE_COUNT = 16;
+    Private std::shared_mutex entityStripes[LOCK_STRIPE_COUNT];
+    Private std::shared_mutex indexMutex;        // ID index; held shared by full scans
+    Private std::mutex cacheMutex;               // LRU entity cache
+    Private std::mutex secondaryIndexMutex;      // secondary index maps and files
+    Private std::mutex idsFileMutex;             // serializes IDs-file commits
+    Private std::mutex checksumMutex;            // per-ID content checksums
+
+    // Enable or disable thread-safe mode
+    // Must not be toggled while operations are in flight
+    Public Void SetThreadSafe(Bool enabled) {
+        threadSafe = enabled;
+        if (enabled) {
+            // Build every lazily cached path now, while nothing is in
+            // flight; their unguarded first-use initialization would
+            // otherwise race under concurrency
+            WarmPathCaches();
+        }
+    }
+
+    // Helper method to pick the lock stripe for an ID
+    Private std::shared_mutex& EntityStripe(ID id) {
+        return entityStripes[std::hash<ID>{}(id) % LOCK_STRIPE_COUNT];
+    }
+
+    // RAII guards that only engage in thread-safe mode
+    Private struct MaybeSharedLock {
+        std::shared_mutex* mutex = nullptr;
+        MaybeSharedLock(std::shared_mutex& m, Bool enabled) {
+            if (enabled) {
+                mutex = &m;
+                mutex->lock_shared();
+            }
+        }
+        ~MaybeSharedLock() {
+            if (mutex) {
+                mutex->unlock_shared();
+            }
+        }
+    };
+    Private struct MaybeUniqueLock {
+        std::shared_mutex* mutex = nullptr;
+        MaybeUniqueLock(std::shared_mutex& m, Bool enabled) {
+            if (enabled) {
+                mutex = &m;
+                mutex->lock();
+            }
+        }
+        // Drop the lock before scope exit; needed where a callee takes
+        // the same stripe (the lock is not recursive)
+        Void Release() {
+            if (mutex) {
+                mutex->unlock();
+                mutex = nullptr;
+            }
+        }
+        ~MaybeUniqueLock() {
+            if (mutex) {
+                mutex->unlock();
+            }
+        }
+    };
+    Private struct MaybeMutexLock {
+        std::mutex* mutex = nullptr;
+        MaybeMutexLock(std::mutex& m, Bool enabled) {
+            if (enabled) {
+                mutex = &m;
+                mutex->lock();
+            }
+        }
+        ~MaybeMutexLock() {
+            if (mutex) {
+                mutex->unlock();
+            }
+        }
+    };
+#endif // ARDUINO
+
     // Private template function to convert ID to string
     // Handles both string types and primitive types
     // Since StdString is a typedef for std::string, we check for std::string
@@ -65,265 +193,2391 @@ class CpaRepositoryImpl : public CpaRepository<Entity, ID> {
         }
     }
 
-    // Helper method to get IDs file path
+    // Path construction hot path: the table/key name prefix and the IDs file
+    // path never change between configuration calls, so both are computed
+    // once instead of re-fetching GetTableName/GetPrimaryKeyName and
+    // concatenating temporaries on every operation. pathScratch is a reused
+    // hash-input buffer so GetFilePath stops allocating once its capacity is
+    // warm.
+    Private StdString cachedNamePrefix;  // tableName + "_" + primaryKeyName + "_"
+    Private StdString cachedIdsFilePath;
+    Private StdString pathScratch;
+
+    // Runtime storage layout. databaseRoot defaults to the DATABASE_PATH
+    // macro; shardedLayout moves entity files into root/table/hh/ bucket
+    // directories (hh = two hex digits of the file hash, 256 buckets) so no
+    // single directory grows past a few thousand entries - past ~500k flat
+    // files, directory lookups measurably slow every Read on ext4/FAT.
+    // Metadata files (IDs, journal, snapshot, secondary indexes) live in
+    // root/table/ beside the buckets. The flat default keeps existing
+    // tables loading unchanged.
+    Private StdString databaseRoot = DATABASE_PATH;
+    Private Bool shardedLayout = false;
+    Private StdString cachedDirectoryPrefix;
+    Private Bool directoryPrefixValid = false;
+
+    // Point this repository at a different storage root, e.g. a per-table
+    // fast volume. Must not be called while operations are in flight; any
+    // files under the previous root are not moved.
+    Public Void SetDatabaseRoot(CStdString& root) {
+        databaseRoot = root;
+        if (!databaseRoot.empty() && databaseRoot[databaseRoot.length() - 1] != '/') {
+            databaseRoot += '/';
+        }
+        InvalidateCachedPaths();
+    }
+
+    // Enable the sharded root/table/hh/ directory layout
+    // Only meaningful on backends with real directories; key-value backends
+    // like ESP32 Preferences should stay flat. Must not be toggled while
+    // operations are in flight, and does not relocate existing files.
+    Public Void SetShardedLayout(Bool enabled) {
+        shardedLayout = enabled;
+        InvalidateCachedPaths();
+    }
+
+    // Drop every cached path so the next operation resolves it through the
+    // current root and layout configuration
+    Private Void InvalidateCachedPaths() {
+        cachedDirectoryPrefix.clear();
+        directoryPrefixValid = false;
+        cachedIdsFilePath.clear();
+        cachedJournalFilePath.clear();
+        cachedSnapshotFilePath.clear();
+#ifndef ARDUINO
+        if (threadSafe) {
+            // Rebuild eagerly so no lazy initialization happens mid-flight
+            WarmPathCaches();
+        }
+#endif
+    }
+
+    // Build every lazily cached path up front
+    // Called from the configuration setters so thread-safe operation never
+    // performs a first-use cache initialization concurrently
+    Private Void WarmPathCaches() {
+        GetNamePrefix();
+        GetDirectoryPrefix();
+        GetIdsFilePath();
+        GetJournalFilePath();
+        GetSnapshotFilePath();
+    }
+
+    // Directory every file of this table resolves under: the configured
+    // root, plus a per-table subdirectory in the sharded layout. Rebuilt
+    // lazily after a configuration change; the first resolution also makes
+    // sure the directories exist on backends that have them.
+    Protected CStdString& GetDirectoryPrefix() {
+        if (!directoryPrefixValid) {
+            cachedDirectoryPrefix = databaseRoot;
+            if (shardedLayout) {
+                cachedDirectoryPrefix += Entity::GetTableName();
+                cachedDirectoryPrefix += '/';
+            }
+            EnsureLayoutDirectories();
+            directoryPrefixValid = true;
+        }
+        return cachedDirectoryPrefix;
+    }
+
+    // Create the configured directory tree where the backend has one
+    // (a no-op on key-value backends via the EnsureDirectory default)
+    Private Void EnsureLayoutDirectories() {
+        if (databaseRoot.empty() && !shardedLayout) {
+            return; // flat layout with no root prefix needs no directories
+        }
+        if (!databaseRoot.empty()) {
+            fileManager->EnsureDirectory(databaseRoot);
+        }
+        if (shardedLayout) {
+            fileManager->EnsureDirectory(cachedDirectoryPrefix);
+            constexpr const char* hexDigits = "0123456789abcdef";
+            StdString bucketPath;
+            for (unsigned bucket = 0; bucket < 256; bucket++) {
+                bucketPath = cachedDirectoryPrefix;
+                bucketPath += hexDigits[(bucket >> 4) & 0xF];
+                bucketPath += hexDigits[bucket & 0xF];
+                fileManager->EnsureDirectory(bucketPath);
+            }
+        }
+    }
+
+    // Append the hh/ bucket directory an entity file hash falls into
+    Private Static Void AppendBucket(StdString& out, uint32_t hash32) {
+        constexpr const char* hexDigits = "0123456789abcdef";
+        out += hexDigits[(hash32 >> 4) & 0xF];
+        out += hexDigits[hash32 & 0xF];
+        out += '/';
+    }
+
+    // Binary entity format support. Entities that provide
+    // SerializeBinary()/DeserializeBinary(CStdString&) are stored in that
+    // representation behind a one-byte format marker; files without the
+    // marker are text and load through Entity::Deserialize, so existing
+    // tables keep working. The text serializationlib format is 3-5x larger
+    // than the data and dominates FindAll CPU, so binary is preferred
+    // whenever the entity offers it.
+    Private template<typename T, typename = void>
+    struct HasBinarySerialization : std::false_type {};
+    Private template<typename T>
+    struct HasBinarySerialization<T, std::void_t<
+        decltype(std::declval<T&>().SerializeBinary()),
+        decltype(T::DeserializeBinary(std::declval<CStdString&>()))>> : std::true_type {};
+
+    // Format marker prefixing binary entity files
+    // The text format never begins with a 0x01 byte
+    Protected Static constexpr char ENTITY_BINARY_MARKER = '\x01';
+
+    Private Bool binaryEntityFormat = true;
+
+    // Select whether new writes use the binary representation
+    // Only effective when the entity provides SerializeBinary/DeserializeBinary
+    Public Void SetBinaryEntityFormat(Bool enabled) {
+        binaryEntityFormat = enabled;
+    }
+
+    // Helper method to serialize an entity in the selected on-disk format
+    Protected StdString SerializeEntity(Entity& entity) {
+        if constexpr (HasBinarySerialization<Entity>::value) {
+            if (binaryEntityFormat) {
+                StdString contents;
+                contents += ENTITY_BINARY_MARKER;
+                contents += entity.SerializeBinary();
+                return contents;
+            }
+        }
+        return entity.Serialize();
+    }
+
+    // Helper method to deserialize an entity, negotiating the format from
+    // the leading marker byte so text and binary files coexist in one table
+    Protected Static Entity DeserializeEntity(CStdString& contents) {
+        if constexpr (HasBinarySerialization<Entity>::value) {
+            if (!contents.empty() && contents[0] == ENTITY_BINARY_MARKER) {
+                StdString payload = contents.substr(1);
+                return Entity::DeserializeBinary(payload);
+            }
+        }
+        return Entity::Deserialize(contents);
+    }
+
+    // Helper method to get the cached table/key file name prefix
+    Protected CStdString& GetNamePrefix() {
+        if (cachedNamePrefix.empty()) {
+            StdString tableName = Entity::GetTableName();
+            StdString primaryKeyName = Entity::GetPrimaryKeyName();
+            cachedNamePrefix = tableName + "_" + primaryKeyName + "_";
+        }
+        return cachedNamePrefix;
+    }
+
+    // Helper method to append an ID to a buffer without heap allocation
+    // Integral IDs are formatted into a fixed stack buffer; strings append
+    // directly; other types fall back to ConvertToString
+    Protected Void AppendIdToBuffer(StdString& out, const ID& id) {
+        if constexpr (std::is_same_v<ID, std::string> || std::is_same_v<ID, StdString>) {
+            out += id;
+        } else if constexpr (std::is_integral_v<ID>) {
+            char buffer[24]; // fits any 64-bit integer plus sign and terminator
+            if constexpr (std::is_signed_v<ID>) {
+                snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(id));
+            } else {
+                snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(id));
+            }
+            out += buffer;
+        } else {
+            out += ConvertToString(id);
+        }
+    }
+
+    // Helper method to get IDs file path (computed once per configuration)
     Protected StdString GetIdsFilePath() {
-        StdString tableName = Entity::GetTableName();
-        return StdString(DATABASE_PATH) + GenerateHash(tableName + "_IDs");
+        if (cachedIdsFilePath.empty()) {
+            StdString tableName = Entity::GetTableName();
+            cachedIdsFilePath = GetDirectoryPrefix() + GenerateHash(tableName + "_IDs");
+        }
+        return cachedIdsFilePath;
     }
 
     // Helper method to generate consistent hash for a string input
     // Returns a hash value as StdString (guaranteed to be <= 14 characters)
-    Protected Static StdString GenerateHash(CStdString input) {
-        // Use std::hash to generate hash, then cast to uint32_t to ensure <= 14 characters
-        // uint32_t max value is 4,294,967,295 (10 digits), which is well within 14 character limit
-        std::hash<StdString> hasher;
-        size_t hashValue = hasher(StdString(input.c_str()));
-        uint32_t hash32 = static_cast<uint32_t>(hashValue);
-        
-        // Convert to string and return
+    // Uses constexpr FNV-1a (CompileTimeHash.h) instead of std::hash: the
+    // result is identical on desktop and ESP32, and inputs known during
+    // compilation fold into constants
+    // uint32_t max value is 4,294,967,295 (10 digits), well within 14 characters
+    Protected Static StdString GenerateHash(CStdString& input) {
+        uint32_t hash32 = Fnv1a32(input.c_str(), input.length());
         return StdString(std::to_string(hash32).c_str());
     }
 
+    // Helper method to build a file path into a caller-owned output buffer
+    // Scan loops recycle both the hash-input scratch and the output buffer,
+    // so path construction stops allocating once capacities are warm (see
+    // OperationArena.h for the wider allocation-churn rationale)
+    Protected Void GetFilePathInto(StdString& out, StdString& scratch, ID id) {
+        scratch.clear(); // keeps its capacity across calls
+        scratch += GetNamePrefix();
+        AppendIdToBuffer(scratch, id);
+        uint32_t hash32 = Fnv1a32(scratch.c_str(), scratch.length());
+        out.assign(GetDirectoryPrefix());
+        if (shardedLayout) {
+            AppendBucket(out, hash32);
+        }
+        char buffer[12]; // fits any 10-digit uint32_t plus terminator
+        snprintf(buffer, sizeof(buffer), "%u", hash32);
+        out += buffer;
+    }
+
+    // Helper method to construct file path into a caller-owned scratch buffer
+    // Used by the parallel scan paths where each thread brings its own buffer
+    Protected StdString GetFilePathWithScratch(StdString& scratch, ID id) {
+        StdString out;
+        GetFilePathInto(out, scratch, id);
+        return out;
+    }
+
     // Helper method to construct file path
+    // Composes cachedNamePrefix + id in the reused scratch buffer, so the
+    // hot FindById/Save path performs no per-call prefix rebuilding.
+    // Thread-safe mode builds into a function-local buffer instead: the
+    // shared scratch would race under the per-ID stripe locks, which do not
+    // serialize operations on different IDs
     Protected StdString GetFilePath(ID id) {
-        // Get table name (static method)
-        StdString tableName = Entity::GetTableName();
-        // Get primary key name (static method)
-        StdString primaryKeyName = Entity::GetPrimaryKeyName();
-        return StdString(DATABASE_PATH) + GenerateHash(tableName + "_" + primaryKeyName + "_" + ConvertToString(id));
+#ifndef ARDUINO
+        if (threadSafe) {
+            StdString localScratch;
+            return GetFilePathWithScratch(localScratch, id);
+        }
+#endif
+        return GetFilePathWithScratch(pathScratch, id);
+    }
+
+    // Selectable IDs file format: newline-delimited text (default, legacy
+    // compatible) or a binary record format with tombstone deletes.
+    // The flag selects the format for writes; reads auto-detect via the
+    // magic header so existing text files keep loading either way.
+    Private Bool binaryIdsFormat = false;
+    Private Bool idsFileIsBinary = false; // format of the on-disk file as last loaded/written
+
+    // Magic header identifying the binary IDs file format
+    Protected Static constexpr char BINARY_IDS_MAGIC[4] = {'S', 'B', 'I', '1'};
+
+    // Select the binary IDs file format for this repository
+    // Deletes become a single appended tombstone record instead of a full
+    // rewrite, and index loading becomes a bulk fixed-width parse
+    Public Void SetBinaryIdsFileFormat(Bool enabled) {
+        binaryIdsFormat = enabled;
+    }
+
+    // Helper method to encode one binary ID record (live or tombstone)
+    // Integral IDs are fixed-width 8-byte little-endian, floating-point IDs
+    // store their 8-byte bit pattern, string IDs are length-prefixed
+    Protected Void EncodeIdRecord(StdString& out, ID id, Bool live) {
+        out += static_cast<char>(live ? 1 : 0);
+        if constexpr (std::is_same_v<ID, std::string> || std::is_same_v<ID, StdString>) {
+            uint32_t idLength = static_cast<uint32_t>(id.length());
+            for (int shift = 0; shift < 32; shift += 8) {
+                out += static_cast<char>((idLength >> shift) & 0xFF);
+            }
+            out.append(id.c_str(), id.length());
+        } else {
+            uint64_t bits;
+            if constexpr (std::is_floating_point_v<ID>) {
+                double value = static_cast<double>(id);
+                static_assert(sizeof(double) == sizeof(uint64_t), "double must be 8 bytes");
+                memcpy(&bits, &value, sizeof(bits));
+            } else {
+                bits = static_cast<uint64_t>(static_cast<int64_t>(id));
+            }
+            for (int shift = 0; shift < 64; shift += 8) {
+                out += static_cast<char>((bits >> shift) & 0xFF);
+            }
+        }
+    }
+
+    // Helper method to decode one binary ID record starting at offset
+    // Advances offset past the record; returns false on a truncated record
+    Protected Bool DecodeIdRecord(const char* data, size_t length, size_t& offset, ID& id, Bool& live) {
+        if (offset >= length) {
+            return false;
+        }
+        live = (data[offset] != 0);
+        offset++;
+        if constexpr (std::is_same_v<ID, std::string> || std::is_same_v<ID, StdString>) {
+            if (offset + 4 > length) {
+                return false;
+            }
+            uint32_t idLength = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                idLength |= static_cast<uint32_t>(static_cast<unsigned char>(data[offset])) << shift;
+                offset++;
+            }
+            if (offset + idLength > length) {
+                return false;
+            }
+            id = ID(data + offset, idLength);
+            offset += idLength;
+        } else {
+            if (offset + 8 > length) {
+                return false;
+            }
+            uint64_t bits = 0;
+            for (int shift = 0; shift < 64; shift += 8) {
+                bits |= static_cast<uint64_t>(static_cast<unsigned char>(data[offset])) << shift;
+                offset++;
+            }
+            if constexpr (std::is_floating_point_v<ID>) {
+                double value;
+                memcpy(&value, &bits, sizeof(value));
+                id = static_cast<ID>(value);
+            } else {
+                id = static_cast<ID>(static_cast<int64_t>(bits));
+            }
+        }
+        return true;
+    }
+
+    // Helper method to parse the binary IDs format, resolving tombstones
+    Protected StdVector<ID> ParseBinaryIds(const char* data, size_t length) {
+        StdVector<ID> ids;
+        std::unordered_set<ID> liveSet;
+
+        size_t offset = sizeof(BINARY_IDS_MAGIC);
+        ID id;
+        Bool live;
+        while (DecodeIdRecord(data, length, offset, id, live)) {
+            if (live) {
+                if (liveSet.insert(id).second) {
+                    ids.push_back(id);
+                }
+            } else if (liveSet.erase(id) > 0) {
+                for (size_t i = 0; i < ids.size(); i++) {
+                    if (ids[i] == id) {
+                        ids.erase(ids.begin() + i);
+                        break;
+                    }
+                }
+            }
+        }
+
+        return ids;
     }
 
     // Helper method to read all IDs from the IDs file
     Protected StdVector<ID> ReadAllIds() {
+        REPOSITORY_STATS_SCOPE(stats.idsLoad);
         StdVector<ID> ids;
         StdString idsFilePath = GetIdsFilePath();
-        CStdString idsFilePathRef = idsFilePath;
-        StdString contents = fileManager->Read(idsFilePathRef);
-        
-        if (contents.empty()) {
+        // Zero-copy view of the IDs file (mmap-backed on desktop)
+        FileMappingPtr mapping = fileManager->ReadMapped(idsFilePath);
+
+        if (!mapping || mapping->Empty()) {
             return ids;
         }
-        
-        // Parse IDs from file (one ID per line)
-        StdString currentId;
-        for (size_t i = 0; i < contents.length(); i++) {
-            char c = contents[i];
-            if (c == '\n' || c == '\r') {
-                if (!currentId.empty()) {
-                    // Convert string to ID using template function
-                    ID id = ConvertFromString<ID>(currentId);
-                    ids.push_back(id);
-                    currentId.clear();
+
+        const char* data = mapping->Data();
+        size_t length = mapping->Length();
+        REPOSITORY_STATS_BYTES(stats.idsLoad, length);
+
+        // Auto-detect the binary format via its magic header
+        if (length >= sizeof(BINARY_IDS_MAGIC) &&
+            memcmp(data, BINARY_IDS_MAGIC, sizeof(BINARY_IDS_MAGIC)) == 0) {
+            idsFileIsBinary = true;
+            return ParseBinaryIds(data, length);
+        }
+        idsFileIsBinary = false;
+
+        // Parse IDs (one ID per line) directly out of the mapping.
+        // FindLineBreak splits records 16 bytes per step where the ISA
+        // allows it, and integral IDs take the branch-light ParseIntegral
+        // path instead of std::stoi's locale and exception machinery; a
+        // line ParseIntegral rejects falls back to the general conversion
+        // so malformed input fails the same way it always did.
+        size_t lineStart = 0;
+        while (lineStart < length) {
+            size_t lineEnd = FindLineBreak(data, lineStart, length);
+            if (lineEnd > lineStart) {
+                if constexpr (std::is_integral_v<ID>) {
+                    ID id;
+                    if (ParseIntegral(data, lineStart, lineEnd, id)) {
+                        ids.push_back(id);
+                    } else {
+                        StdString currentId(data + lineStart, lineEnd - lineStart);
+                        ids.push_back(ConvertFromString<ID>(currentId));
+                    }
+                } else {
+                    StdString currentId(data + lineStart, lineEnd - lineStart);
+                    ids.push_back(ConvertFromString<ID>(currentId));
                 }
-            } else {
-                currentId += c;
             }
+            lineStart = lineEnd + 1;
         }
-        
-        // Handle last ID if file doesn't end with newline
-        if (!currentId.empty()) {
-            ID id = ConvertFromString<ID>(currentId);
-            ids.push_back(id);
-        }
-        
+
         return ids;
     }
 
-    // Helper method to write all IDs to the IDs file
+    // Helper method to write all IDs to the IDs file in the selected format
+    // In binary mode this also compacts away any accumulated tombstones
     Protected Void WriteAllIds(const StdVector<ID>& ids) {
+#ifndef ARDUINO
+        MaybeMutexLock idsFileGuard(idsFileMutex, threadSafe);
+#endif
         StdString idsFilePath = GetIdsFilePath();
         StdString contents;
-        
-        for (size_t i = 0; i < ids.size(); i++) {
-            contents += ConvertToString(ids[i]);
-            contents += StdString("\n"); // Always add newline, including after last ID
+
+        if (binaryIdsFormat) {
+            contents.append(BINARY_IDS_MAGIC, sizeof(BINARY_IDS_MAGIC));
+            for (size_t i = 0; i < ids.size(); i++) {
+                EncodeIdRecord(contents, ids[i], true);
+            }
+            idsFileIsBinary = true;
+        } else {
+            for (size_t i = 0; i < ids.size(); i++) {
+                contents += ConvertToString(ids[i]);
+                contents += StdString("\n"); // Always add newline, including after last ID
+            }
+            idsFileIsBinary = false;
         }
-        
-        CStdString idsFilePathRef = idsFilePath;
-        CStdString contentsRef = contents;
-        fileManager->Create(idsFilePathRef, contentsRef);
+
+        // Atomic mode replaces the IDs file via temp-plus-rename; a crash
+        // mid-rewrite otherwise truncates the whole table's ID list
+        CommitFile(idsFilePath, contents);
     }
 
-    // Helper method to check if ID exists in the IDs file
-    Protected Bool IdExistsInFile(ID id) {
-        StdVector<ID> ids = ReadAllIds();
-        for (const auto& existingId : ids) {
-            if (existingId == id) {
-                return true;
+    // Helper method to append one new ID to the IDs file in the selected format
+    // Migrates a legacy text file to the binary format on first binary append
+    Protected Void AppendIdToFile(ID id) {
+        EnsureIdIndexLoaded();
+
+        if (binaryIdsFormat) {
+            // Index size is read under the index lock and before the file
+            // lock: the journal replay path commits the IDs file while
+            // holding the index, so the reverse nesting would deadlock
+            size_t indexSize;
+            {
+#ifndef ARDUINO
+                MaybeSharedLock indexGuard(indexMutex, threadSafe);
+#endif
+                indexSize = idList.size();
+            }
+            {
+#ifndef ARDUINO
+                MaybeMutexLock idsFileGuard(idsFileMutex, threadSafe);
+#endif
+                if (idsFileIsBinary || indexSize <= 1) {
+                    StdString idsFilePath = GetIdsFilePath();
+                    StdString record;
+                    // The magic header is written only when the on-disk file
+                    // is not binary yet (fresh or empty table). A table
+                    // emptied by deletes still carries its header plus
+                    // tombstones, and a second header would parse as a
+                    // phantom record
+                    if (!idsFileIsBinary) {
+                        record.append(BINARY_IDS_MAGIC, sizeof(BINARY_IDS_MAGIC));
+                    }
+                    EncodeIdRecord(record, id, true);
+                    fileManager->Append(idsFilePath, record);
+                    idsFileIsBinary = true;
+                    return;
+                }
             }
+            // An existing text-format file can't take binary records;
+            // rewrite it once (outside the file guard - the rewrite takes it)
+            WriteAllIdsFromIndex();
+            return;
         }
-        return false;
+
+        // Text format: one ID per line
+#ifndef ARDUINO
+        MaybeMutexLock idsFileGuard(idsFileMutex, threadSafe);
+#endif
+        StdString idsFilePath = GetIdsFilePath();
+        StdString idStr = ConvertToString(id) + StdString("\n");
+        fileManager->Append(idsFilePath, idStr);
     }
 
-    // Create: Save a new entity
-    Public Virtual Entity Save(Entity& entity) override {
-        // Get generated ID (non-static method)
-        optional<ID> generatedId = entity.GetPrimaryKey();
-        
-        if(generatedId.has_value()) {
-            ID id = generatedId.value();
-            
-            // Construct file path: DATABASE_PATH/TableName_PrimaryKeyName_ID
-            StdString filePath = GetFilePath(id);
-            
-            // Serialize entity (non-static method)
-            StdString contents = entity.Serialize();
-            
-            // Save to file using file manager
-            CStdString filePathRef = filePath;
-            CStdString contentsRef = contents;
-            fileManager->Create(filePathRef, contentsRef);
-            
-            // Append ID to IDs file if it doesn't already exist
-            if (!IdExistsInFile(id)) {
+    // Helper method to commit ID removals to the IDs file
+    // Binary format appends one tombstone record per removed ID (no rewrite);
+    // text format rewrites the file from the in-memory index
+    Protected Void RemoveIdsFromFile(const StdVector<ID>& removedIds) {
+        if (binaryIdsFormat) {
+#ifndef ARDUINO
+            MaybeMutexLock idsFileGuard(idsFileMutex, threadSafe);
+#endif
+            // The format flag is only stable under the file guard
+            if (idsFileIsBinary) {
                 StdString idsFilePath = GetIdsFilePath();
-                StdString idStr = ConvertToString(id) + StdString("\n");
-                CStdString idsFilePathRef = idsFilePath;
-                CStdString idStrRef = idStr;
-                fileManager->Append(idsFilePathRef, idStrRef);
+                StdString records;
+                for (const auto& id : removedIds) {
+                    EncodeIdRecord(records, id, false);
+                }
+                fileManager->Append(idsFilePath, records);
+                return;
             }
         }
-        
-        return entity;
+        WriteAllIdsFromIndex();
     }
 
-    // Read: Find entity by ID
-    Public Virtual optional<Entity> FindById(ID id) override {
-        // Construct file path
-        StdString filePath = GetFilePath(id);
-        
-        // Read file contents
-        CStdString filePathRef = filePath;
-        StdString contents = fileManager->Read(filePathRef);
-        
-        // Check if file was read successfully (non-empty content)
-        if (contents.empty()) {
-            return std::nullopt;
-        }
-        
-        // Deserialize entity (Deserialize is a static method)
-        Entity entity = Entity::Deserialize(contents);
-        
-        return entity;
-    }
-    // Read: Find all entities
-    Public Virtual StdVector<Entity> FindAll() override {
-        StdVector<Entity> entities;
-        
-        // Read all IDs from the IDs file
-        StdVector<ID> ids = ReadAllIds();
-        
-        // For each ID, read and deserialize the entity
-        for (const auto& id : ids) {
-            StdString filePath = GetFilePath(id);
-            CStdString filePathRef = filePath;
-            StdString contents = fileManager->Read(filePathRef);
-            
-            if (!contents.empty()) {
-                // Deserialize entity (Deserialize is a static method)
-                Entity entity = Entity::Deserialize(contents);
-                entities.push_back(entity);
+    // Helper method to commit the in-memory ID index to the IDs file
+    // Thread-safe mode snapshots the list under the index lock first, so
+    // the rewrite does not race concurrent index mutations
+    Protected Void WriteAllIdsFromIndex() {
+#ifndef ARDUINO
+        if (threadSafe) {
+            StdVector<ID> idsCopy;
+            {
+                MaybeSharedLock indexGuard(indexMutex, threadSafe);
+                idsCopy = idList;
             }
+            WriteAllIds(idsCopy);
+            return;
         }
-        
-        return entities;
+#endif
+        WriteAllIds(idList);
     }
 
-    // Update: Update an existing entity
-    Public Virtual Entity Update(Entity& entity) override {
-        // Get ID from entity
-        optional<ID> id = entity.GetPrimaryKey();
-        
-        if(id.has_value()) {
-            ID entityId = id.value();
-            
-            // Construct file path
-            StdString filePath = GetFilePath(entityId);
-            
-            // Serialize entity
-            StdString contents = entity.Serialize();
-            
-            // Update file using file manager
-            CStdString filePathRef = filePath;
-            CStdString contentsRef = contents;
-            fileManager->Update(filePathRef, contentsRef);
-            
-            // Add ID to IDs file if it doesn't already exist (for Update on non-existent entity)
-            if (!IdExistsInFile(entityId)) {
-                StdString idsFilePath = GetIdsFilePath();
-                
-                // Read current file to check if it ends with newline
-                CStdString idsFilePathRef = idsFilePath;
-                StdString currentContents = fileManager->Read(idsFilePathRef);
-                
-                // Ensure we append with proper newline
-                StdString idStr;
-                if (currentContents.empty()) {
-                    idStr = ConvertToString(entityId) + StdString("\n");
-                } else {
-                    // Check if last character is newline
-                    if (currentContents.length() > 0 && 
-                        currentContents[currentContents.length() - 1] != '\n' &&
-                        currentContents[currentContents.length() - 1] != '\r') {
-                        // File doesn't end with newline, add one before appending
-                        idStr = StdString("\n") + ConvertToString(entityId) + StdString("\n");
-                    } else {
-                        // File ends with newline, just append ID with newline
-                        idStr = ConvertToString(entityId) + StdString("\n");
-                    }
-                }
-                
-                CStdString idStrRef = idStr;
-                fileManager->Append(idsFilePathRef, idStrRef);
-            }
+    // Atomic commit mode, off by default. Entity and IDs files are committed
+    // through IFileManager::CreateAtomic (temp-file-plus-rename on desktop;
+    // ESP32 Preferences replaces values atomically already), and new IDs are
+    // recorded in a write-ahead journal before the entity file exists. A
+    // crash between the entity write and the IDs append leaves a journal
+    // record instead of an invisible orphan; startup replays only the
+    // journal tail instead of rescanning the table.
+    Private Bool atomicCommit = false;
+    Private StdString cachedJournalFilePath;
+    Private size_t journaledCount = 0;
+
+    // Journal records tolerated before a checkpoint truncates the file
+    Private Static constexpr size_t JOURNAL_CHECKPOINT = 256;
+
+    // Enable or disable atomic commit mode
+    // Enabling replays any journal left behind by a crashed run
+    Public Void SetAtomicCommit(Bool enabled) {
+        Bool enabling = enabled && !atomicCommit;
+        atomicCommit = enabled;
+        if (enabling && idIndexLoaded) {
+#ifndef ARDUINO
+            MaybeUniqueLock indexGuard(indexMutex, threadSafe);
+#endif
+            ReplayJournalLocked();
         }
-        
-        return entity;
     }
 
-    // Delete: Delete entity by ID
-    Public Virtual Void DeleteById(ID id) override {
-        // Check if entity exists before attempting to delete
-        if (!ExistsById(id)) {
-            // Entity doesn't exist, nothing to delete
-            return;
-        }
-        
-        // Construct file path
-        StdString filePath = GetFilePath(id);
-        
-        // Delete file using file manager
-        CStdString filePathRef = filePath;
-        fileManager->Delete(filePathRef);
-        
-        // Remove ID from IDs file
-        StdVector<ID> ids = ReadAllIds();
-        StdVector<ID> updatedIds;
-        for (const auto& existingId : ids) {
-            if (existingId != id) {
-                updatedIds.push_back(existingId);
-            }
+    // Helper method to get the journal file path (computed once per instance)
+    Protected StdString GetJournalFilePath() {
+        if (cachedJournalFilePath.empty()) {
+            StdString tableName = Entity::GetTableName();
+            cachedJournalFilePath = GetDirectoryPrefix() + GenerateHash(tableName + "_Journal");
         }
-        WriteAllIds(updatedIds);
+        return cachedJournalFilePath;
     }
 
-    // Delete: Delete an entity
-    Public Virtual Void Delete(Entity& entity) override {
-        // Get ID from entity
-        optional<ID> id = entity.GetPrimaryKey();
-        
-        if(id.has_value()) {
-            // Use DeleteById to delete
-            DeleteById(id.value());
+    // Helper method to commit a full file in the selected durability mode
+    Protected Void CommitFile(CStdString& filename, CStdString& contents) {
+        if (atomicCommit) {
+            fileManager->CreateAtomic(filename, contents);
+        } else {
+            fileManager->Create(filename, contents);
         }
     }
 
-    // Check if entity exists by ID
+    // Helper method to journal a new ID ahead of its entity write
+    Protected Void JournalAppend(ID id) {
+        StdString journalPath = GetJournalFilePath();
+        StdString record = ConvertToString(id) + StdString("\n");
+        fileManager->Append(journalPath, record);
+        journaledCount++;
+    }
+
+    // Helper method to drop the journal once its records are all committed
+    Protected Void ClearJournal() {
+        StdString journalPath = GetJournalFilePath();
+        fileManager->Delete(journalPath);
+        journaledCount = 0;
+    }
+
+    // Helper method to checkpoint the journal once it grows past the limit
+    // Every completed Save has fully committed its records, so the journal
+    // is safe to drop whenever no batched writes are pending
+    Protected Void MaybeCheckpointJournal() {
+        if (journaledCount < JOURNAL_CHECKPOINT) {
+            return;
+        }
+        if (writeBatching && (!pendingWrites.empty() || !pendingDeletes.empty())) {
+            return;
+        }
+        ClearJournal();
+    }
+
+    // Helper method to replay the journal tail after a crash
+    // For each journaled ID whose entity file exists but which the IDs file
+    // never learned, the ID is re-added and the IDs file rewritten once.
+    // Caller holds the index exclusively; idList/idSet are touched directly.
+    Protected Void ReplayJournalLocked() {
+        StdString journalPath = GetJournalFilePath();
+        StdString contents = fileManager->Read(journalPath);
+        if (contents.empty()) {
+            return;
+        }
+
+        Bool idsChanged = false;
+        StdString currentId;
+        for (size_t i = 0; i <= contents.length(); i++) {
+            if (i == contents.length() || contents[i] == '\n' || contents[i] == '\r') {
+                if (!currentId.empty()) {
+                    ID id = ConvertFromString<ID>(currentId);
+                    currentId.clear();
+                    if (idSet.count(id) == 0) {
+                        // Orphaned entity: file committed, IDs append lost
+                        StdString filePath = GetFilePath(id);
+                        if (!fileManager->Read(filePath).empty()) {
+                            idSet.insert(id);
+                            idList.push_back(id);
+                            idsChanged = true;
+                        }
+                    }
+                }
+            } else {
+                currentId += contents[i];
+            }
+        }
+
+        if (idsChanged) {
+            WriteAllIds(idList);
+        }
+        ClearJournal();
+    }
+
+    // Snapshot facility for fast cold starts. WriteSnapshot serializes the
+    // whole table (ID index plus entity payloads) into one contiguous file;
+    // LoadSnapshot maps it (mmap-backed on desktop) and serves FindById and
+    // full scans straight from the mapping, so the service is ready after a
+    // single map instead of N open-read-deserialize round trips. A desktop
+    // background pass then verifies every snapshot entry against its
+    // per-entity file and drops the ones that went stale; writes and deletes
+    // invalidate their snapshot entry immediately either way. The slice map
+    // is always mutex-guarded on desktop because the verifier is a real
+    // second thread; the shared ID index is only guarded in thread-safe
+    // mode, so background verification is honored solely in that mode and
+    // LoadSnapshot verifies synchronously otherwise.
+    Private FileMappingPtr snapshotMapping;
+    Private struct SnapshotSlice {
+        size_t offset;
+        size_t length;
+    };
+    Private std::unordered_map<ID, SnapshotSlice> snapshotSlices;
+    Private Bool snapshotActive = false;
+    Private StdString cachedSnapshotFilePath;
+#ifndef ARDUINO
+    Private std::mutex snapshotMutex;    // snapshot slice map and mapping
+    Private std::thread snapshotVerifier;
+#endif
+
+    // Magic header identifying the snapshot file format
+    Protected Static constexpr char SNAPSHOT_MAGIC[4] = {'S', 'B', 'S', '1'};
+
+    // Helper method to get the snapshot file path (computed once per instance)
+    Protected StdString GetSnapshotFilePath() {
+        if (cachedSnapshotFilePath.empty()) {
+            StdString tableName = Entity::GetTableName();
+            cachedSnapshotFilePath = GetDirectoryPrefix() + GenerateHash(tableName + "_Snapshot");
+        }
+        return cachedSnapshotFilePath;
+    }
+
+    // Write the whole table into one contiguous snapshot file
+    // Record layout after the magic: ID record (EncodeIdRecord), then a
+    // 4-byte little-endian payload length, then the raw entity file bytes
+    Public Void WriteSnapshot() {
+        if (writeBatching) {
+            Flush();
+        }
+
+        const StdVector<ID>& ids = GetAllIds();
+
+        StdString contents;
+        contents.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+
+        {
+#ifndef ARDUINO
+            MaybeSharedLock indexGuard(indexMutex, threadSafe);
+#endif
+            for (const auto& id : ids) {
+                StdString filePath = GetFilePath(id);
+                StdString payload = fileManager->Read(filePath);
+                if (payload.empty()) {
+                    continue;
+                }
+                EncodeIdRecord(contents, id, true);
+                uint32_t payloadLength = static_cast<uint32_t>(payload.length());
+                for (int shift = 0; shift < 32; shift += 8) {
+                    contents += static_cast<char>((payloadLength >> shift) & 0xFF);
+                }
+                contents += payload;
+            }
+        }
+
+        StdString snapshotPath = GetSnapshotFilePath();
+        CommitFile(snapshotPath, contents);
+    }
+
+    // Map the snapshot and start serving reads from it
+    // Populates the ID index from the snapshot when it isn't loaded yet, so
+    // startup performs one map instead of touching per-entity files. In
+    // thread-safe mode on desktop a background thread verifies the entries
+    // afterwards; otherwise verification runs synchronously before this
+    // returns (pass false to force that in thread-safe mode too).
+    Public Bool LoadSnapshot(Bool verifyInBackground = true) {
+        StdString snapshotPath = GetSnapshotFilePath();
+        FileMappingPtr mapping = fileManager->ReadMapped(snapshotPath);
+        if (!mapping || mapping->Length() < sizeof(SNAPSHOT_MAGIC) ||
+            memcmp(mapping->Data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+            return false;
+        }
+
+        const char* data = mapping->Data();
+        size_t length = mapping->Length();
+        size_t offset = sizeof(SNAPSHOT_MAGIC);
+
+        std::unordered_map<ID, SnapshotSlice> slices;
+        StdVector<ID> snapshotIds;
+        ID id;
+        Bool live;
+        while (DecodeIdRecord(data, length, offset, id, live)) {
+            if (offset + 4 > length) {
+                break; // truncated record
+            }
+            uint32_t payloadLength = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                payloadLength |= static_cast<uint32_t>(static_cast<unsigned char>(data[offset])) << shift;
+                offset++;
+            }
+            if (offset + payloadLength > length) {
+                break;
+            }
+            slices[id] = SnapshotSlice{offset, payloadLength};
+            snapshotIds.push_back(id);
+            offset += payloadLength;
+        }
+
+        {
+#ifndef ARDUINO
+            std::lock_guard<std::mutex> snapshotGuard(snapshotMutex);
+#endif
+            snapshotMapping = mapping;
+            snapshotSlices = std::move(slices);
+            snapshotActive = true;
+        }
+
+        // Cold start: adopt the snapshot's ID index instead of parsing the
+        // IDs file; the verification pass reconciles against it afterwards
+        if (!idIndexLoaded) {
+#ifndef ARDUINO
+            MaybeUniqueLock indexGuard(indexMutex, threadSafe);
+#endif
+            if (!idIndexLoaded) {
+                idList = std::move(snapshotIds);
+                idSet.clear();
+                for (const auto& snapshotId : idList) {
+                    idSet.insert(snapshotId);
+                }
+                idIndexLoaded = true;
+                if (atomicCommit) {
+                    ReplayJournalLocked();
+                }
+            }
+        }
+
+#ifndef ARDUINO
+        // The verifier shares the ID index with normal operations through
+        // the Maybe* guards, which only engage in thread-safe mode - so a
+        // background thread is spawned only there. Without the gate, plain
+        // single-threaded LoadSnapshot(); Save(...) would race a second
+        // thread on the index.
+        if (verifyInBackground && threadSafe) {
+            if (snapshotVerifier.joinable()) {
+                snapshotVerifier.join();
+            }
+            snapshotVerifier = std::thread([this]() { VerifySnapshot(); });
+            return true;
+        }
+#endif
+        VerifySnapshot();
+        return true;
+    }
+
+    // Verify every snapshot entry against the authoritative on-disk state
+    // Reconciles the ID index with the IDs file and drops snapshot slices
+    // whose entity file is missing or has different bytes
+    Public Void VerifySnapshot() {
+        // IDs written after the snapshot exist only in the IDs file; the
+        // file guard serializes this read (and its format-flag update)
+        // against concurrent IDs-file commits in thread-safe mode
+        StdVector<ID> diskIds;
+        {
+#ifndef ARDUINO
+            MaybeMutexLock idsFileGuard(idsFileMutex, threadSafe);
+#endif
+            diskIds = ReadAllIds();
+        }
+        if (!diskIds.empty()) {
+#ifndef ARDUINO
+            MaybeUniqueLock indexGuard(indexMutex, threadSafe);
+#endif
+            for (const auto& id : diskIds) {
+                if (idSet.insert(id).second) {
+                    idList.push_back(id);
+                }
+            }
+        }
+
+        // Snapshot of the slice keys so file reads happen outside the lock
+        StdVector<ID> snapshotIds;
+        {
+#ifndef ARDUINO
+            std::lock_guard<std::mutex> snapshotGuard(snapshotMutex);
+#endif
+            snapshotIds.reserve(snapshotSlices.size());
+            for (const auto& entry : snapshotSlices) {
+                snapshotIds.push_back(entry.first);
+            }
+        }
+
+        StdString scratch;
+        for (const auto& id : snapshotIds) {
+            StdString filePath = GetFilePathWithScratch(scratch, id);
+            StdString fileContents = fileManager->Read(filePath);
+
+            Bool stale;
+            {
+#ifndef ARDUINO
+                std::lock_guard<std::mutex> snapshotGuard(snapshotMutex);
+#endif
+                auto slice = snapshotSlices.find(id);
+                if (slice == snapshotSlices.end()) {
+                    continue; // invalidated by a write while we verified
+                }
+                stale = fileContents.length() != slice->second.length ||
+                        memcmp(fileContents.c_str(),
+                               snapshotMapping->Data() + slice->second.offset,
+                               slice->second.length) != 0;
+                if (stale) {
+                    snapshotSlices.erase(slice);
+                }
+            }
+        }
+    }
+
+    // Helper method to serve one entity's raw contents from the snapshot
+    // Returns false when the snapshot is inactive or no longer covers the ID
+    Protected Bool SnapshotGet(ID id, StdString& contents) {
+        if (!snapshotActive) {
+            return false;
+        }
+#ifndef ARDUINO
+        std::lock_guard<std::mutex> snapshotGuard(snapshotMutex);
+#endif
+        auto slice = snapshotSlices.find(id);
+        if (slice == snapshotSlices.end()) {
+            return false;
+        }
+        contents.assign(snapshotMapping->Data() + slice->second.offset,
+                        slice->second.length);
+        return true;
+    }
+
+    // Helper method to drop an ID's snapshot entry after a write or delete
+    Protected Void SnapshotInvalidate(ID id) {
+        if (!snapshotActive) {
+            return;
+        }
+#ifndef ARDUINO
+        std::lock_guard<std::mutex> snapshotGuard(snapshotMutex);
+#endif
+        snapshotSlices.erase(id);
+    }
+
+    // In-memory ID index: hash set for O(1) existence checks plus an
+    // insertion-ordered list that mirrors the IDs file contents.
+    // Lazily populated from the IDs file on first use, then kept coherent
+    // across Save/Update/DeleteById so writes no longer re-read the file.
+    Private Bool idIndexLoaded = false;
+    Private StdVector<ID> idList;
+    Private std::unordered_set<ID> idSet;
+
+    // Helper method to populate the in-memory ID index from the IDs file
+    // Only reads the file once; subsequent calls are no-ops
+    Protected Void EnsureIdIndexLoaded() {
+        if (idIndexLoaded) {
+            return;
+        }
+#ifndef ARDUINO
+        MaybeUniqueLock indexGuard(indexMutex, threadSafe);
+        if (idIndexLoaded) {
+            return; // another thread loaded the index while we waited
+        }
+#endif
+        idList = ReadAllIds();
+        idSet.clear();
+        for (const auto& id : idList) {
+            idSet.insert(id);
+        }
+        idIndexLoaded = true;
+
+        // Fast crash recovery: replay the journal tail left by an
+        // interrupted run instead of rescanning the whole table
+        if (atomicCommit) {
+            ReplayJournalLocked();
+        }
+    }
+
+    // Helper method to get all IDs from the in-memory index
+    // Loads the index from the IDs file on first call
+    Protected const StdVector<ID>& GetAllIds() {
+        EnsureIdIndexLoaded();
+        return idList;
+    }
+
+    // Helper method to add an ID to the in-memory index
+    // Returns true if the ID was newly added, false if it already existed
+    Protected Bool IdIndexAdd(ID id) {
+        EnsureIdIndexLoaded();
+#ifndef ARDUINO
+        MaybeUniqueLock indexGuard(indexMutex, threadSafe);
+#endif
+        if (idSet.insert(id).second) {
+            idList.push_back(id);
+            return true;
+        }
+        return false;
+    }
+
+    // Helper method to remove an ID from the in-memory index
+    Protected Void IdIndexRemove(ID id) {
+        EnsureIdIndexLoaded();
+#ifndef ARDUINO
+        MaybeUniqueLock indexGuard(indexMutex, threadSafe);
+#endif
+        if (idSet.erase(id) > 0) {
+            for (size_t i = 0; i < idList.size(); i++) {
+                if (idList[i] == id) {
+                    idList.erase(idList.begin() + i);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Helper method to check if ID exists
+    // Uses the in-memory index instead of re-reading the IDs file
+    Protected Bool IdExistsInFile(ID id) {
+        EnsureIdIndexLoaded();
+#ifndef ARDUINO
+        MaybeSharedLock indexGuard(indexMutex, threadSafe);
+#endif
+        return idSet.count(id) > 0;
+    }
+
+    // Per-ID content checksums alongside the ID index. Update hashes the
+    // serialized bytes and skips the fileManager->Update call when the
+    // checksum matches what is already stored, so a sync loop that calls
+    // Update for every entity only pays file writes (and flash erase cycles
+    // on ESP32) for the fraction that actually changed. Checksums are
+    // learned on Save/Update and on FindById reads, so the skip also works
+    // after a restart once an entity has been read back.
+    Private std::unordered_map<ID, uint32_t> contentChecksums;
+
+    // Helper method to look up the stored checksum for an ID
+    Protected optional<uint32_t> ChecksumGet(ID id) {
+#ifndef ARDUINO
+        MaybeMutexLock checksumGuard(checksumMutex, threadSafe);
+#endif
+        auto found = contentChecksums.find(id);
+        if (found == contentChecksums.end()) {
+            return std::nullopt;
+        }
+        return found->second;
+    }
+
+    // Helper method to record the checksum of an ID's serialized contents
+    Protected Void ChecksumPut(ID id, uint32_t checksum) {
+#ifndef ARDUINO
+        MaybeMutexLock checksumGuard(checksumMutex, threadSafe);
+#endif
+        contentChecksums[id] = checksum;
+    }
+
+    // Helper method to drop an ID's checksum (used on delete)
+    Protected Void ChecksumErase(ID id) {
+#ifndef ARDUINO
+        MaybeMutexLock checksumGuard(checksumMutex, threadSafe);
+#endif
+        contentChecksums.erase(id);
+    }
+
+    // Optional bounded LRU entity cache, disabled by default (capacity 0)
+    // Write-through on Save/Update, invalidated on delete, so hot FindById
+    // calls return from memory without touching the IFileManager at all
+    Private size_t entityCacheCapacity = 0;
+    Private std::list<std::pair<ID, Entity>> entityCacheOrder; // front = most recently used
+    Private std::unordered_map<ID, typename std::list<std::pair<ID, Entity>>::iterator> entityCacheMap;
+
+    // Enable the entity cache with the given maximum entry count
+    // A capacity of 0 disables the cache and drops all cached entities
+    Public Void SetEntityCacheCapacity(size_t capacity) {
+#ifndef ARDUINO
+        MaybeMutexLock cacheGuard(cacheMutex, threadSafe);
+#endif
+        entityCacheCapacity = capacity;
+        while (entityCacheOrder.size() > entityCacheCapacity) {
+            entityCacheMap.erase(entityCacheOrder.back().first);
+            entityCacheOrder.pop_back();
+        }
+    }
+
+    // Helper method to insert or refresh an entity in the cache (write-through)
+    Protected Void EntityCachePut(ID id, const Entity& entity) {
+        if (entityCacheCapacity == 0) {
+            return;
+        }
+#ifndef ARDUINO
+        MaybeMutexLock cacheGuard(cacheMutex, threadSafe);
+#endif
+        auto found = entityCacheMap.find(id);
+        if (found != entityCacheMap.end()) {
+            entityCacheOrder.erase(found->second);
+            entityCacheMap.erase(found);
+        }
+        entityCacheOrder.push_front(std::make_pair(id, entity));
+        entityCacheMap[id] = entityCacheOrder.begin();
+        // Evict the least recently used entry once over capacity
+        if (entityCacheOrder.size() > entityCacheCapacity) {
+            entityCacheMap.erase(entityCacheOrder.back().first);
+            entityCacheOrder.pop_back();
+        }
+    }
+
+    // Helper method to look up an entity in the cache
+    // A hit moves the entry to the front of the LRU order
+    Protected optional<Entity> EntityCacheGet(ID id) {
+#ifndef ARDUINO
+        MaybeMutexLock cacheGuard(cacheMutex, threadSafe);
+#endif
+        auto found = entityCacheMap.find(id);
+        if (found == entityCacheMap.end()) {
+            return std::nullopt;
+        }
+        entityCacheOrder.splice(entityCacheOrder.begin(), entityCacheOrder, found->second);
+        return entityCacheOrder.front().second;
+    }
+
+    // Helper method to invalidate a cached entity (used on delete)
+    Protected Void EntityCacheErase(ID id) {
+#ifndef ARDUINO
+        MaybeMutexLock cacheGuard(cacheMutex, threadSafe);
+#endif
+        auto found = entityCacheMap.find(id);
+        if (found != entityCacheMap.end()) {
+            entityCacheOrder.erase(found->second);
+            entityCacheMap.erase(found);
+        }
+    }
+
+    // Secondary index subsystem for generated FindBy query methods
+    // Each registered field keeps a persistent value -> ID-list index file
+    // (plus an ID -> value reverse map in memory) maintained on every
+    // Save/Update/Delete, so a findByX lookup is two file reads instead of
+    // a full-table scan through FindAll
+    //
+    // The file is a base image ("value<TAB>id" lines) followed by appended
+    // log records ("+<TAB>value<TAB>id" / "-<TAB>value<TAB>id") that are
+    // replayed on load. Writes append their records instead of rewriting
+    // the whole file, and a full rewrite happens only when the log outgrows
+    // the live entries - the same cheap-append-plus-periodic-compaction
+    // shape as the binary IDs file's tombstones
+    Private struct SecondaryIndex {
+        std::function<StdString(const Entity&)> extractor;
+        Bool loaded = false;
+        std::unordered_map<StdString, StdVector<ID>> valueToIds;
+        std::unordered_map<ID, StdString> idToValue;
+        size_t appendedOps = 0; // log records since the last full rewrite
+    };
+    Private std::unordered_map<StdString, SecondaryIndex> secondaryIndexes;
+
+    // Register a secondary index on a field
+    // The extractor returns the field's value (as string) for an entity;
+    // generated findByX methods can then call FindByIndexed(fieldName, value)
+    Public Void RegisterIndex(CStdString& fieldName, std::function<StdString(const Entity&)> extractor) {
+#ifndef ARDUINO
+        MaybeMutexLock secondaryGuard(secondaryIndexMutex, threadSafe);
+#endif
+        SecondaryIndex& index = secondaryIndexes[fieldName];
+        index.extractor = extractor;
+        index.loaded = false;
+    }
+
+    // Helper method to get the index file path for a field
+    Protected StdString GetIndexFilePath(CStdString& fieldName) {
+        StdString tableName = Entity::GetTableName();
+        return GetDirectoryPrefix() + GenerateHash(tableName + "_Index_" + fieldName);
+    }
+
+    // Helper method to load one secondary index from its file
+    // Rebuilds the index from a table scan when the file is missing or stale
+    Protected Void EnsureSecondaryIndexLoaded(CStdString& fieldName, SecondaryIndex& index) {
+        if (index.loaded) {
+            return;
+        }
+        index.valueToIds.clear();
+        index.idToValue.clear();
+
+        StdString indexFilePath = GetIndexFilePath(fieldName);
+        StdString contents = fileManager->Read(indexFilePath);
+
+        if (!contents.empty()) {
+            // Parse the base image ("value<TAB>id" lines, also the legacy
+            // format) and replay any appended log records on top
+            StdString line;
+            for (size_t i = 0; i <= contents.length(); i++) {
+                if (i == contents.length() || contents[i] == '\n' || contents[i] == '\r') {
+                    if (!line.empty()) {
+                        ApplyIndexLine(index, line);
+                    }
+                    line.clear();
+                } else {
+                    line += contents[i];
+                }
+            }
+            index.loaded = true;
+            return;
+        }
+
+        // No index file yet: build it once from the existing table
+        index.loaded = true;
+        if (!GetAllIds().empty()) {
+            ForEach([&](Entity& entity) -> Bool {
+                optional<ID> id = entity.GetPrimaryKey();
+                if (id.has_value()) {
+                    StdString value = index.extractor(entity);
+                    index.valueToIds[value].push_back(id.value());
+                    index.idToValue[id.value()] = value;
+                }
+                return true;
+            });
+            PersistSecondaryIndex(fieldName, index);
+        }
+    }
+
+    // Helper method to apply one index file line to the in-memory maps
+    // Log records carry a leading op field; anything else is a base-image
+    // (or legacy) "value<TAB>id" entry. A plain value of "+" or "-" is
+    // unambiguous because log records always carry a second tab
+    Private Void ApplyIndexLine(SecondaryIndex& index, CStdString& line) {
+        size_t tab = line.find('\t');
+        if (tab == StdString::npos) {
+            return;
+        }
+        if (tab == 1 && (line[0] == '+' || line[0] == '-')) {
+            size_t secondTab = line.find('\t', tab + 1);
+            if (secondTab != StdString::npos) {
+                StdString value = line.substr(tab + 1, secondTab - tab - 1);
+                ID id = ConvertFromString<ID>(line.substr(secondTab + 1));
+                auto existing = index.idToValue.find(id);
+                if (existing != index.idToValue.end()) {
+                    RemoveIndexEntry(index, existing->second, id);
+                    index.idToValue.erase(existing);
+                }
+                if (line[0] == '+') {
+                    index.valueToIds[value].push_back(id);
+                    index.idToValue[id] = value;
+                }
+                index.appendedOps++;
+                return;
+            }
+        }
+        StdString value = line.substr(0, tab);
+        ID id = ConvertFromString<ID>(line.substr(tab + 1));
+        index.valueToIds[value].push_back(id);
+        index.idToValue[id] = value;
+    }
+
+    // Helper method to encode one index log record
+    Private Void EncodeIndexOp(StdString& out, char op, CStdString& value, ID id) {
+        out += op;
+        out += '\t';
+        out += value;
+        out += '\t';
+        out += ConvertToString(id);
+        out += '\n';
+    }
+
+    // Helper method to commit log records to an index file
+    // Appends instead of rewriting, so a Save against a large indexed table
+    // costs one small append rather than an O(table) rewrite; the file is
+    // compacted back to its base image once the log dominates the live
+    // entries (64 floors the threshold so small tables don't rewrite
+    // constantly)
+    Protected Void CommitIndexOps(CStdString& fieldName, SecondaryIndex& index,
+                                  CStdString& ops, size_t opCount) {
+        StdString indexFilePath = GetIndexFilePath(fieldName);
+        fileManager->Append(indexFilePath, ops);
+        index.appendedOps += opCount;
+        if (index.appendedOps >= 64 && index.appendedOps >= index.idToValue.size()) {
+            PersistSecondaryIndex(fieldName, index);
+        }
+    }
+
+    // Helper method to rewrite one secondary index file from memory
+    // This is the compaction step; the rewritten file carries no log tail
+    Protected Void PersistSecondaryIndex(CStdString& fieldName, SecondaryIndex& index) {
+        StdString contents;
+        for (const auto& entry : index.valueToIds) {
+            for (const auto& id : entry.second) {
+                contents += entry.first;
+                contents += StdString("\t");
+                contents += ConvertToString(id);
+                contents += StdString("\n");
+            }
+        }
+
+        StdString indexFilePath = GetIndexFilePath(fieldName);
+        CommitFile(indexFilePath, contents);
+        index.appendedOps = 0;
+    }
+
+    // Helper method to update all registered indexes after a Save/Update
+    Protected Void UpdateIndexesOnWrite(ID id, const Entity& entity) {
+#ifndef ARDUINO
+        MaybeMutexLock secondaryGuard(secondaryIndexMutex, threadSafe);
+#endif
+        for (auto& entry : secondaryIndexes) {
+            CStdString& fieldName = entry.first;
+            SecondaryIndex& index = entry.second;
+            EnsureSecondaryIndexLoaded(fieldName, index);
+
+            StdString newValue = index.extractor(entity);
+            StdString ops;
+            size_t opCount = 0;
+            auto oldValue = index.idToValue.find(id);
+            if (oldValue != index.idToValue.end()) {
+                if (oldValue->second == newValue) {
+                    continue; // value unchanged, nothing to persist
+                }
+                EncodeIndexOp(ops, '-', oldValue->second, id);
+                opCount++;
+                RemoveIndexEntry(index, oldValue->second, id);
+            }
+            EncodeIndexOp(ops, '+', newValue, id);
+            opCount++;
+            index.valueToIds[newValue].push_back(id);
+            index.idToValue[id] = newValue;
+            CommitIndexOps(fieldName, index, ops, opCount);
+        }
+    }
+
+    // Helper method to drop an ID from all registered indexes after a delete
+    Protected Void UpdateIndexesOnDelete(ID id) {
+#ifndef ARDUINO
+        MaybeMutexLock secondaryGuard(secondaryIndexMutex, threadSafe);
+#endif
+        for (auto& entry : secondaryIndexes) {
+            CStdString& fieldName = entry.first;
+            SecondaryIndex& index = entry.second;
+            EnsureSecondaryIndexLoaded(fieldName, index);
+
+            auto oldValue = index.idToValue.find(id);
+            if (oldValue == index.idToValue.end()) {
+                continue;
+            }
+            StdString ops;
+            EncodeIndexOp(ops, '-', oldValue->second, id);
+            RemoveIndexEntry(index, oldValue->second, id);
+            index.idToValue.erase(oldValue);
+            CommitIndexOps(fieldName, index, ops, 1);
+        }
+    }
+
+    // Helper method to remove one value -> ID pair from an index
+    Private Void RemoveIndexEntry(SecondaryIndex& index, CStdString& value, ID id) {
+        auto bucket = index.valueToIds.find(value);
+        if (bucket == index.valueToIds.end()) {
+            return;
+        }
+        StdVector<ID>& ids = bucket->second;
+        for (size_t i = 0; i < ids.size(); i++) {
+            if (ids[i] == id) {
+                ids.erase(ids.begin() + i);
+                break;
+            }
+        }
+        if (ids.empty()) {
+            index.valueToIds.erase(bucket);
+        }
+    }
+
+    // Find all entities whose indexed field equals the given value
+    // Two lookups (index bucket, then the bucket's entity files) instead of
+    // deserializing the whole table
+    Public StdVector<Entity> FindByIndexed(CStdString& fieldName, CStdString& value) {
+        StdVector<Entity> entities;
+
+        // Snapshot the bucket's IDs under the index lock, then read the
+        // entities after releasing it (FindById takes entity stripe locks)
+        StdVector<ID> matchingIds;
+        {
+#ifndef ARDUINO
+            MaybeMutexLock secondaryGuard(secondaryIndexMutex, threadSafe);
+#endif
+            auto entry = secondaryIndexes.find(fieldName);
+            if (entry == secondaryIndexes.end()) {
+                return entities; // field is not indexed
+            }
+            EnsureSecondaryIndexLoaded(fieldName, entry->second);
+
+            auto bucket = entry->second.valueToIds.find(value);
+            if (bucket == entry->second.valueToIds.end()) {
+                return entities;
+            }
+            matchingIds = bucket->second;
+        }
+
+        entities.reserve(matchingIds.size());
+        for (const auto& id : matchingIds) {
+            optional<Entity> entity = FindById(id);
+            if (entity.has_value()) {
+                entities.push_back(std::move(entity.value()));
+            }
+        }
+
+        return entities;
+    }
+
+    // Find the first entity whose indexed field equals the given value
+    Public optional<Entity> FindOneByIndexed(CStdString& fieldName, CStdString& value) {
+        optional<ID> matchingId;
+        {
+#ifndef ARDUINO
+            MaybeMutexLock secondaryGuard(secondaryIndexMutex, threadSafe);
+#endif
+            auto entry = secondaryIndexes.find(fieldName);
+            if (entry == secondaryIndexes.end()) {
+                return std::nullopt;
+            }
+            EnsureSecondaryIndexLoaded(fieldName, entry->second);
+
+            auto bucket = entry->second.valueToIds.find(value);
+            if (bucket == entry->second.valueToIds.end() || bucket->second.empty()) {
+                return std::nullopt;
+            }
+            matchingId = bucket->second[0];
+        }
+
+        return FindById(matchingId.value());
+    }
+
+    // Group-commit write batching, off by default. When enabled, Save/Update
+    // buffer serialized entities (and deletes) in memory and Flush() commits
+    // them as one coalesced pass with a single IDs-file write, instead of an
+    // open/trunc/write/close per Save plus a second open for the IDs append.
+    // Reads consult the buffers so batched state stays visible; full scans
+    // flush first. Time-based flushing is left to the caller (invoke Flush()
+    // from a timer).
+    Private Bool writeBatching = false;
+    Private size_t flushThreshold = 0; // pending ops before auto-flush; 0 = explicit Flush() only
+    Private std::unordered_map<ID, StdString> pendingWrites; // serialized contents awaiting commit
+    Private std::unordered_set<ID> pendingDeletes;
+    Private Bool pendingIdsDirty = false;
+#ifndef ARDUINO
+    Private std::mutex batchMutex; // guards the pending buffers in thread-safe mode
+#endif
+
+    // Enable or disable write batching
+    // threshold > 0 auto-flushes once that many operations are pending;
+    // disabling flushes whatever is buffered
+    Public Void SetWriteBatching(Bool enabled, size_t threshold = 0) {
+        if (writeBatching && !enabled) {
+            Flush();
+        }
+        writeBatching = enabled;
+        flushThreshold = threshold;
+    }
+
+    // Commit all buffered writes, deletes and the IDs file in one pass
+    //
+    // Each entry is committed under its ID's stripe lock and removed from
+    // the pending buffers only after its file is on disk. Swapping the
+    // buffers out first and committing unlocked left a window where a
+    // concurrent FindById saw neither the buffer entry nor a complete
+    // file (a truncating write in progress) and returned nullopt for an
+    // entity that exists. Callers must not hold a stripe lock here.
+    Public Void Flush() {
+        StdVector<ID> writeIds;
+        StdVector<ID> deleteIds;
+        {
+#ifndef ARDUINO
+            MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+            writeIds.reserve(pendingWrites.size());
+            for (const auto& entry : pendingWrites) {
+                writeIds.push_back(entry.first);
+            }
+            deleteIds.reserve(pendingDeletes.size());
+            for (const auto& id : pendingDeletes) {
+                deleteIds.push_back(id);
+            }
+        }
+
+        for (const auto& id : writeIds) {
+#ifndef ARDUINO
+            MaybeUniqueLock stripeGuard(EntityStripe(id), threadSafe);
+#endif
+            StdString contents;
+            Bool stillPending = false;
+            {
+#ifndef ARDUINO
+                MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+                auto pending = pendingWrites.find(id);
+                if (pending != pendingWrites.end()) {
+                    contents = pending->second;
+                    stillPending = true;
+                }
+            }
+            // Deleted meanwhile, or committed by a concurrent Flush
+            if (!stillPending) {
+                continue;
+            }
+            StdString filePath = GetFilePath(id);
+            CommitFile(filePath, contents);
+            {
+#ifndef ARDUINO
+                MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+                // The stripe lock blocks concurrent writers of this ID,
+                // so the entry still holds exactly what was committed
+                pendingWrites.erase(id);
+            }
+        }
+
+        for (const auto& id : deleteIds) {
+#ifndef ARDUINO
+            MaybeUniqueLock stripeGuard(EntityStripe(id), threadSafe);
+#endif
+            Bool stillPending = false;
+            {
+#ifndef ARDUINO
+                MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+                stillPending = pendingDeletes.count(id) > 0;
+            }
+            // Re-saved meanwhile, or handled by a concurrent Flush
+            if (!stillPending) {
+                continue;
+            }
+            StdString filePath = GetFilePath(id);
+            fileManager->Delete(filePath);
+            {
+#ifndef ARDUINO
+                MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+                pendingDeletes.erase(id);
+            }
+        }
+
+        // The IDs file is written once per flush instead of once per save
+        Bool idsDirty;
+        {
+#ifndef ARDUINO
+            MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+            idsDirty = pendingIdsDirty;
+            pendingIdsDirty = false;
+        }
+        if (idsDirty) {
+            WriteAllIdsFromIndex();
+        }
+
+        // Everything buffered is now on disk; old journal records are stale
+        MaybeCheckpointJournal();
+    }
+
+    // Helper method to auto-flush once the pending count crosses the threshold
+    // Callers release their stripe lock first: Flush takes every pending
+    // ID's stripe, and the stripe locks are not recursive
+    Protected Void MaybeFlushOnThreshold() {
+        if (flushThreshold == 0) {
+            return;
+        }
+        size_t pendingCount;
+        {
+#ifndef ARDUINO
+            MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+            pendingCount = pendingWrites.size() + pendingDeletes.size();
+        }
+        if (pendingCount >= flushThreshold) {
+            Flush();
+        }
+    }
+
+    // Helper method holding the Save logic shared by the lvalue and rvalue
+    // overloads, so neither pays a copy of the entity on the way in
+    Protected Void SaveInternal(Entity& entity) {
+        REPOSITORY_STATS_SCOPE(stats.save);
+        // Get generated ID (non-static method)
+        optional<ID> generatedId = entity.GetPrimaryKey();
+
+        if(generatedId.has_value()) {
+            ID id = generatedId.value();
+
+#ifndef ARDUINO
+            // Exclusive stripe lock for this ID while writing
+            MaybeUniqueLock stripeGuard(EntityStripe(id), threadSafe);
+#endif
+
+            // Serialize entity (non-static method)
+            StdString contents = SerializeEntity(entity);
+            REPOSITORY_STATS_BYTES(stats.save, contents.length());
+
+            // Remember the content checksum so a later identical Update skips
+            ChecksumPut(id, Fnv1a32(contents.c_str(), contents.length()));
+
+            // The mapped snapshot no longer matches this entity
+            SnapshotInvalidate(id);
+
+            // Write-ahead journal: record a new ID before its entity file
+            // exists, so a crash between the two writes is repaired by replay
+            if (atomicCommit && !IdExistsInFile(id)) {
+                JournalAppend(id);
+            }
+
+            if (writeBatching) {
+                // Buffer the serialized entity; Flush() commits it. The
+                // dirty flag must be set inside the same critical section
+                // that mutates the buffers: set after the guard it races a
+                // concurrent Flush and the IDs-file commit is lost
+                {
+#ifndef ARDUINO
+                    MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+                    pendingDeletes.erase(id);
+                    pendingWrites[id] = contents;
+                    if (IdIndexAdd(id)) {
+                        pendingIdsDirty = true;
+                    }
+                }
+                EntityCachePut(id, entity);
+                UpdateIndexesOnWrite(id, entity);
+#ifndef ARDUINO
+                stripeGuard.Release();
+#endif
+                MaybeFlushOnThreshold();
+                return;
+            }
+
+            // Construct file path through the configured root and layout
+            StdString filePath = GetFilePath(id);
+
+            // Save to file using file manager (atomically when selected)
+            CommitFile(filePath, contents);
+
+            // Write-through to the entity cache
+            EntityCachePut(id, entity);
+
+            // Keep registered secondary indexes coherent
+            UpdateIndexesOnWrite(id, entity);
+
+            // Append ID to IDs file only if the in-memory index didn't know it yet
+            if (IdIndexAdd(id)) {
+                AppendIdToFile(id);
+            }
+
+            // Both writes are committed; old journal records are now stale
+            MaybeCheckpointJournal();
+        }
+    }
+
+    // Create: Save a new entity
+    Public Virtual Entity Save(Entity& entity) override {
+        SaveInternal(entity);
+        return entity;
+    }
+
+    // Create: Save a new entity passed as an rvalue
+    // The stored entity is moved back out, so saving a temporary (or an
+    // explicitly moved DTO) performs zero entity copies
+    Public Virtual Entity Save(Entity&& entity) override {
+        SaveInternal(entity);
+        return std::move(entity);
+    }
+
+    // Create: Save a batch of entities with a single IDs-file commit
+    // Writes every entity file first, then rewrites the IDs file exactly once
+    // instead of performing an existence check plus Append per entity
+    Public Virtual StdVector<Entity> SaveAll(StdVector<Entity>& entities) override {
+        if (writeBatching) {
+            // Batching mode already coalesces the IDs commit; buffer each entity
+            for (auto& entity : entities) {
+                Save(entity);
+            }
+            return entities;
+        }
+
+        Bool idsChanged = false;
+
+        for (auto& entity : entities) {
+            // Get generated ID (non-static method)
+            optional<ID> generatedId = entity.GetPrimaryKey();
+
+            if (generatedId.has_value()) {
+                ID id = generatedId.value();
+
+#ifndef ARDUINO
+                // Exclusive stripe lock for this ID while writing
+                MaybeUniqueLock stripeGuard(EntityStripe(id), threadSafe);
+#endif
+
+                // Construct file path and serialize entity
+                StdString filePath = GetFilePath(id);
+                StdString contents = SerializeEntity(entity);
+
+                // Remember the content checksum so a later identical Update skips
+                ChecksumPut(id, Fnv1a32(contents.c_str(), contents.length()));
+
+                // The mapped snapshot no longer matches this entity
+                SnapshotInvalidate(id);
+
+                // Journal new IDs ahead of their entity writes; the batch's
+                // single IDs-file commit happens after every file is written
+                if (atomicCommit && !IdExistsInFile(id)) {
+                    JournalAppend(id);
+                }
+
+                // Save to file using file manager (atomically when selected)
+                CommitFile(filePath, contents);
+
+                // Write-through to the entity cache
+                EntityCachePut(id, entity);
+
+                // Keep registered secondary indexes coherent
+                UpdateIndexesOnWrite(id, entity);
+
+                // Track new IDs in the in-memory index; file commit happens once below
+                if (IdIndexAdd(id)) {
+                    idsChanged = true;
+                }
+            }
+        }
+
+        // Commit the IDs file exactly once for the whole batch
+        if (idsChanged) {
+            WriteAllIdsFromIndex();
+        }
+
+        // The whole batch is committed; old journal records are now stale
+        MaybeCheckpointJournal();
+
+        return entities;
+    }
+
+    // Read: Find entity by ID
+    Public Virtual optional<Entity> FindById(ID id) override {
+        REPOSITORY_STATS_SCOPE(stats.findById);
+#ifndef ARDUINO
+        // Shared stripe lock: lookups on different IDs run fully parallel
+        MaybeSharedLock stripeGuard(EntityStripe(id), threadSafe);
+#endif
+
+        // Serve hot entities straight from the LRU cache when enabled
+        optional<Entity> cached = EntityCacheGet(id);
+        if (cached.has_value()) {
+            return cached;
+        }
+
+        // Batched state not yet on disk must stay visible to readers
+        if (writeBatching) {
+#ifndef ARDUINO
+            MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+            if (pendingDeletes.count(id) > 0) {
+                return std::nullopt;
+            }
+            auto pending = pendingWrites.find(id);
+            if (pending != pendingWrites.end()) {
+                Entity entity = DeserializeEntity(pending->second);
+                return entity;
+            }
+        }
+
+        // Serve from the mapped snapshot while it still covers this ID
+        {
+            StdString snapshotContents;
+            if (SnapshotGet(id, snapshotContents)) {
+                // Checksums are deliberately not learned here: until the
+                // verifier confirms this slice, the entity file may differ
+                Entity entity = DeserializeEntity(snapshotContents);
+                EntityCachePut(id, entity);
+                return entity;
+            }
+        }
+
+        // Construct file path
+        StdString filePath = GetFilePath(id);
+
+        // Read file contents as a zero-copy view (mmap-backed on desktop)
+        FileMappingPtr mapping = fileManager->ReadMapped(filePath);
+
+        // Check if file was read successfully (non-empty content)
+        if (!mapping || mapping->Empty()) {
+            return std::nullopt;
+        }
+
+        // Single bulk copy out of the mapping for Deserialize's StdString interface
+        StdString contents(mapping->Data(), mapping->Length());
+        REPOSITORY_STATS_BYTES(stats.findById, contents.length());
+
+        // Learn the on-disk checksum so Update can skip unchanged rewrites
+        // even when the entity was last written before a restart
+        ChecksumPut(id, Fnv1a32(contents.c_str(), contents.length()));
+
+        // Deserialize entity (Deserialize is a static method)
+        Entity entity = DeserializeEntity(contents);
+
+        // Remember the entity for subsequent lookups
+        EntityCachePut(id, entity);
+
+        return entity;
+    }
+    // Read: Find all entities
+    Public Virtual StdVector<Entity> FindAll() override {
+        REPOSITORY_STATS_SCOPE(stats.findAll);
+        StdVector<Entity> entities;
+
+        // Full scans read entity files; commit any batched state first
+        if (writeBatching) {
+            Flush();
+        }
+
+        // Read all IDs from the in-memory index (loaded from the IDs file once)
+        const StdVector<ID>& ids = GetAllIds();
+
+#ifndef ARDUINO
+        // Hold the index shared for the whole scan so writers can't mutate
+        // the ID list underneath the iteration
+        MaybeSharedLock indexGuard(indexMutex, threadSafe);
+#endif
+
+        // One up-front allocation instead of push_back growth reallocations
+        entities.reserve(ids.size());
+
+        // For each ID, read and deserialize the entity (served from the
+        // mapped snapshot while it covers the ID). The three buffers are
+        // reused across iterations so their capacity is recycled.
+        StdString filePath;
+        StdString pathInput;
+        StdString contents;
+        for (const auto& id : ids) {
+            contents.clear();
+            if (!SnapshotGet(id, contents)) {
+                GetFilePathInto(filePath, pathInput, id);
+                fileManager->ReadInto(filePath, contents);
+            }
+
+            if (!contents.empty()) {
+                // Deserialize straight into the vector; no intermediate copy
+                entities.emplace_back(DeserializeEntity(contents));
+            }
+        }
+
+        return entities;
+    }
+
+    // Read: Find one page of entities (pageNumber is zero-based)
+    // Skips to the requested offset in the ID list and only reads the page's
+    // entity files, so a dashboard page costs at most pageSize file reads
+    // instead of a full-table scan
+    Public Virtual StdVector<Entity> FindAll(size_t pageNumber, size_t pageSize) override {
+        REPOSITORY_STATS_SCOPE(stats.findAll);
+        StdVector<Entity> entities;
+
+        if (pageSize == 0) {
+            return entities;
+        }
+
+        // Page reads touch entity files; commit any batched state first
+        if (writeBatching) {
+            Flush();
+        }
+
+        // Read all IDs from the in-memory index (loaded from the IDs file once)
+        const StdVector<ID>& ids = GetAllIds();
+
+#ifndef ARDUINO
+        // Hold the index shared for the whole scan so writers can't mutate
+        // the ID list underneath the iteration
+        MaybeSharedLock indexGuard(indexMutex, threadSafe);
+#endif
+
+        size_t offset = pageNumber * pageSize;
+        if (offset >= ids.size()) {
+            return entities;
+        }
+
+        size_t end = offset + pageSize;
+        if (end > ids.size()) {
+            end = ids.size();
+        }
+
+        // One up-front allocation instead of push_back growth reallocations
+        entities.reserve(end - offset);
+
+        // Only read the entity files belonging to the requested slice,
+        // recycling the buffers across iterations
+        StdString filePath;
+        StdString pathInput;
+        StdString contents;
+        for (size_t i = offset; i < end; i++) {
+            contents.clear();
+            if (!SnapshotGet(ids[i], contents)) {
+                GetFilePathInto(filePath, pathInput, ids[i]);
+                fileManager->ReadInto(filePath, contents);
+            }
+
+            if (!contents.empty()) {
+                // Deserialize straight into the vector; no intermediate copy
+                entities.emplace_back(DeserializeEntity(contents));
+            }
+        }
+
+        return entities;
+    }
+
+    // Helper method to copy the ID list sorted by primary key
+    // When k is smaller than the table, partial_sort places only the first
+    // k IDs and the copy is truncated, so top-K never sorts the whole tail
+    Protected StdVector<ID> SortedIds(Bool ascending, size_t k) {
+        // Sorted reads touch entity files; commit any batched state first
+        if (writeBatching) {
+            Flush();
+        }
+        EnsureIdIndexLoaded();
+
+        StdVector<ID> ids;
+        {
+#ifndef ARDUINO
+            MaybeSharedLock indexGuard(indexMutex, threadSafe);
+#endif
+            ids = idList;
+        }
+
+        if (k < ids.size()) {
+            if (ascending) {
+                std::partial_sort(ids.begin(), ids.begin() + k, ids.end());
+            } else {
+                std::partial_sort(ids.begin(), ids.begin() + k, ids.end(), std::greater<ID>());
+            }
+            ids.resize(k);
+        } else {
+            if (ascending) {
+                std::sort(ids.begin(), ids.end());
+            } else {
+                std::sort(ids.begin(), ids.end(), std::greater<ID>());
+            }
+        }
+        return ids;
+    }
+
+    // Helper method to read and deserialize the entities for an ID list,
+    // preserving the list's order (served from the snapshot when mapped)
+    Protected StdVector<Entity> ReadEntitiesForIds(const StdVector<ID>& ids) {
+        StdVector<Entity> entities;
+        entities.reserve(ids.size());
+
+        StdString filePath;
+        StdString pathInput;
+        StdString contents;
+        for (const auto& id : ids) {
+            contents.clear();
+            if (!SnapshotGet(id, contents)) {
+                GetFilePathInto(filePath, pathInput, id);
+                fileManager->ReadInto(filePath, contents);
+            }
+            if (!contents.empty()) {
+                entities.emplace_back(DeserializeEntity(contents));
+            }
+        }
+        return entities;
+    }
+
+    // Read: Find all entities ordered by primary key
+    // Sorts the lightweight ID list, then deserializes in sorted order, so
+    // no application-side sort of materialized entities is needed
+    Public Virtual StdVector<Entity> FindAllSorted(Bool ascending) override {
+        StdVector<ID> ids = SortedIds(ascending, static_cast<size_t>(-1));
+        return ReadEntitiesForIds(ids);
+    }
+
+    // Read: Find the first K entities in primary-key order
+    // The dashboard "latest 100" case: descending top-K deserializes only
+    // the K newest entities instead of the whole table
+    Public Virtual StdVector<Entity> FindTopK(size_t k, Bool ascending) override {
+        if (k == 0) {
+            return StdVector<Entity>();
+        }
+        StdVector<ID> ids = SortedIds(ascending, k);
+        return ReadEntitiesForIds(ids);
+    }
+
+    // Count: Number of entities in the table
+    // Answered from the in-memory ID index without reading any entity files
+    Public Virtual size_t Count() override {
+        EnsureIdIndexLoaded();
+#ifndef ARDUINO
+        MaybeSharedLock indexGuard(indexMutex, threadSafe);
+#endif
+        return idList.size();
+    }
+
+    // Read: Stream all entities one at a time through a callback
+    // Unlike FindAll this never materializes the whole table: one entity is
+    // deserialized at a time into a reused buffer, so memory stays O(1) in
+    // table size. The callback returns false to stop iteration early.
+    Public Virtual Void ForEach(std::function<Bool(Entity&)> callback) override {
+        // Full scans read entity files; commit any batched state first
+        if (writeBatching) {
+            Flush();
+        }
+
+        // Read all IDs from the in-memory index (loaded from the IDs file once)
+        const StdVector<ID>& ids = GetAllIds();
+
+#ifndef ARDUINO
+        // Hold the index shared for the whole scan so writers can't mutate
+        // the ID list underneath the iteration
+        MaybeSharedLock indexGuard(indexMutex, threadSafe);
+#endif
+
+        // Reused across iterations so the read buffer's capacity is recycled
+        StdString filePath;
+        StdString pathInput;
+        StdString contents;
+
+        for (const auto& id : ids) {
+            contents.clear();
+            if (!SnapshotGet(id, contents)) {
+                GetFilePathInto(filePath, pathInput, id);
+                fileManager->ReadInto(filePath, contents);
+            }
+
+            if (!contents.empty()) {
+                // Deserialize entity (Deserialize is a static method)
+                Entity entity = DeserializeEntity(contents);
+                if (!callback(entity)) {
+                    return;
+                }
+            }
+        }
+    }
+
+#ifndef ARDUINO
+    // Read: Find all entities, reading and deserializing in parallel
+    // Partitions the ID list across a pool of threads; each thread reads and
+    // deserializes its slice with its own buffers, and the slices are merged
+    // back in ID-list order. Worth it when Entity::Deserialize dominates the
+    // scan; threadCount 0 uses the hardware concurrency.
+    Public StdVector<Entity> FindAllParallel(size_t threadCount = 0) {
+        if (threadCount == 0) {
+            threadCount = std::thread::hardware_concurrency();
+            if (threadCount == 0) {
+                threadCount = 1;
+            }
+        }
+
+        // Full scans read entity files; commit any batched state first
+        if (writeBatching) {
+            Flush();
+        }
+
+        // Snapshot the ID list so worker threads iterate stable storage
+        EnsureIdIndexLoaded();
+        StdVector<ID> ids;
+        {
+            MaybeSharedLock indexGuard(indexMutex, threadSafe);
+            ids = idList;
+        }
+
+        if (ids.size() < 2 || threadCount < 2) {
+            return FindAll();
+        }
+        if (threadCount > ids.size()) {
+            threadCount = ids.size();
+        }
+
+        // Warm the shared name prefix before spawning so workers only read it
+        GetNamePrefix();
+
+        StdVector<StdVector<Entity>> slices(threadCount);
+        StdVector<std::thread> threads;
+        size_t chunk = (ids.size() + threadCount - 1) / threadCount;
+
+        for (size_t t = 0; t < threadCount; t++) {
+            size_t begin = t * chunk;
+            size_t end = begin + chunk;
+            if (end > ids.size()) {
+                end = ids.size();
+            }
+            threads.emplace_back([this, &ids, &slices, t, begin, end]() {
+                StdString scratch;
+                StdString filePath;
+                StdString contents;
+                for (size_t i = begin; i < end; i++) {
+                    contents.clear();
+                    if (!SnapshotGet(ids[i], contents)) {
+                        GetFilePathInto(filePath, scratch, ids[i]);
+                        fileManager->ReadInto(filePath, contents);
+                    }
+                    if (!contents.empty()) {
+                        slices[t].push_back(DeserializeEntity(contents));
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Merge slices preserving ID-list order; entities move, never copy
+        StdVector<Entity> entities;
+        entities.reserve(ids.size());
+        for (auto& slice : slices) {
+            for (auto& entity : slice) {
+                entities.push_back(std::move(entity));
+            }
+        }
+        return entities;
+    }
+
+    // Read: Stream all entities through a callback from a pool of threads
+    // Explicit opt-in to concurrent callback invocation: the callback runs on
+    // multiple threads at once and must be thread-safe. Returning false stops
+    // new work, though entities already in flight may still be delivered.
+    Public Void ForEachParallel(std::function<Bool(Entity&)> callback, size_t threadCount = 0) {
+        if (threadCount == 0) {
+            threadCount = std::thread::hardware_concurrency();
+            if (threadCount == 0) {
+                threadCount = 1;
+            }
+        }
+
+        // Full scans read entity files; commit any batched state first
+        if (writeBatching) {
+            Flush();
+        }
+
+        // Snapshot the ID list so worker threads iterate stable storage
+        EnsureIdIndexLoaded();
+        StdVector<ID> ids;
+        {
+            MaybeSharedLock indexGuard(indexMutex, threadSafe);
+            ids = idList;
+        }
+
+        if (ids.size() < 2 || threadCount < 2) {
+            ForEach(callback);
+            return;
+        }
+        if (threadCount > ids.size()) {
+            threadCount = ids.size();
+        }
+
+        // Warm the shared name prefix before spawning so workers only read it
+        GetNamePrefix();
+
+        std::atomic<Bool> stopped{false};
+        StdVector<std::thread> threads;
+        size_t chunk = (ids.size() + threadCount - 1) / threadCount;
+
+        for (size_t t = 0; t < threadCount; t++) {
+            size_t begin = t * chunk;
+            size_t end = begin + chunk;
+            if (end > ids.size()) {
+                end = ids.size();
+            }
+            threads.emplace_back([this, &ids, &callback, &stopped, begin, end]() {
+                StdString scratch;
+                StdString filePath;
+                StdString contents;
+                for (size_t i = begin; i < end && !stopped.load(); i++) {
+                    contents.clear();
+                    if (!SnapshotGet(ids[i], contents)) {
+                        GetFilePathInto(filePath, scratch, ids[i]);
+                        fileManager->ReadInto(filePath, contents);
+                    }
+                    if (!contents.empty()) {
+                        Entity entity = DeserializeEntity(contents);
+                        if (!callback(entity)) {
+                            stopped.store(true);
+                            return;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+#endif // ARDUINO
+
+    // Helper method holding the Update logic shared by the lvalue and rvalue
+    // overloads, so neither pays a copy of the entity on the way in
+    Protected Void UpdateInternal(Entity& entity) {
+        REPOSITORY_STATS_SCOPE(stats.update);
+        // Get ID from entity
+        optional<ID> id = entity.GetPrimaryKey();
+        
+        if(id.has_value()) {
+            ID entityId = id.value();
+
+#ifndef ARDUINO
+            // Exclusive stripe lock for this ID while writing
+            MaybeUniqueLock stripeGuard(EntityStripe(entityId), threadSafe);
+#endif
+
+            // Serialize entity
+            StdString contents = SerializeEntity(entity);
+            REPOSITORY_STATS_BYTES(stats.update, contents.length());
+
+            // Skip the write entirely when the serialized contents match what
+            // was last written or read for this ID; a sync loop re-saving an
+            // unchanged entity then costs one Serialize plus one hash
+            uint32_t checksum = Fnv1a32(contents.c_str(), contents.length());
+            optional<uint32_t> storedChecksum = ChecksumGet(entityId);
+            if (storedChecksum.has_value() && storedChecksum.value() == checksum) {
+                EntityCachePut(entityId, entity); // keep the LRU entry warm
+                return;
+            }
+            ChecksumPut(entityId, checksum);
+
+            // The mapped snapshot no longer matches this entity
+            SnapshotInvalidate(entityId);
+
+            // Write-ahead journal: Update can introduce a new ID as well
+            if (atomicCommit && !IdExistsInFile(entityId)) {
+                JournalAppend(entityId);
+            }
+
+            if (writeBatching) {
+                // Buffer the serialized entity; Flush() commits it. The
+                // dirty flag is set inside the buffer guard so it cannot be
+                // lost against a concurrent Flush
+                {
+#ifndef ARDUINO
+                    MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+                    pendingDeletes.erase(entityId);
+                    pendingWrites[entityId] = contents;
+                    if (IdIndexAdd(entityId)) {
+                        pendingIdsDirty = true;
+                    }
+                }
+                EntityCachePut(entityId, entity);
+                UpdateIndexesOnWrite(entityId, entity);
+#ifndef ARDUINO
+                stripeGuard.Release();
+#endif
+                MaybeFlushOnThreshold();
+                return;
+            }
+
+            // Construct file path
+            StdString filePath = GetFilePath(entityId);
+
+            // Update file using file manager; atomic mode replaces via
+            // temp-plus-rename so a crash never leaves a truncated entity
+            if (atomicCommit) {
+                fileManager->CreateAtomic(filePath, contents);
+            } else {
+                fileManager->Update(filePath, contents);
+            }
+
+            // Write-through to the entity cache
+            EntityCachePut(entityId, entity);
+
+            // Keep registered secondary indexes coherent
+            UpdateIndexesOnWrite(entityId, entity);
+
+
+            // Add ID to IDs file if it doesn't already exist (for Update on non-existent entity)
+            if (IdIndexAdd(entityId)) {
+                AppendIdToFile(entityId);
+            }
+
+            // Both writes are committed; old journal records are now stale
+            MaybeCheckpointJournal();
+        }
+    }
+
+    // Update: Update an existing entity
+    Public Virtual Entity Update(Entity& entity) override {
+        UpdateInternal(entity);
+        return entity;
+    }
+
+    // Update: Update an existing entity passed as an rvalue
+    // The stored entity is moved back out, so updating with a temporary
+    // performs zero entity copies
+    Public Virtual Entity Update(Entity&& entity) override {
+        UpdateInternal(entity);
+        return std::move(entity);
+    }
+
+    // Delete: Delete entity by ID
+    Public Virtual Void DeleteById(ID id) override {
+        REPOSITORY_STATS_SCOPE(stats.deleteById);
+#ifndef ARDUINO
+        // Exclusive stripe lock for this ID while deleting
+        MaybeUniqueLock stripeGuard(EntityStripe(id), threadSafe);
+#endif
+
+        // Check if entity exists before attempting to delete
+        if (!ExistsByIdUnlocked(id)) {
+            // Entity doesn't exist, nothing to delete
+            return;
+        }
+
+        if (writeBatching) {
+            // Remove from the in-memory index before publishing the dirty
+            // flag, so any Flush that consumes the flag already sees the
+            // trimmed index. The existence check above means the ID set
+            // always shrinks, so the flag is set unconditionally - inside
+            // the buffer guard, where a concurrent Flush cannot lose it
+            IdIndexRemove(id);
+            {
+#ifndef ARDUINO
+                MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+                pendingWrites.erase(id);
+                pendingDeletes.insert(id);
+                pendingIdsDirty = true;
+            }
+            EntityCacheErase(id);
+            ChecksumErase(id);
+            SnapshotInvalidate(id);
+            UpdateIndexesOnDelete(id);
+#ifndef ARDUINO
+            stripeGuard.Release();
+#endif
+            MaybeFlushOnThreshold();
+            return;
+        }
+
+        // Construct file path
+        StdString filePath = GetFilePath(id);
+
+        // Delete file using file manager
+        fileManager->Delete(filePath);
+        
+        // Drop the cached entity, if any
+        EntityCacheErase(id);
+        ChecksumErase(id);
+        SnapshotInvalidate(id);
+
+        // Keep registered secondary indexes coherent
+        UpdateIndexesOnDelete(id);
+
+        // Remove ID from the in-memory index, then commit the removal
+        // (tombstone append in binary format, full rewrite in text format)
+        IdIndexRemove(id);
+        StdVector<ID> removedIds;
+        removedIds.push_back(id);
+        RemoveIdsFromFile(removedIds);
+    }
+
+    // Delete: Delete a batch of entities by ID with a single IDs-file commit
+    // Deletes every entity file first, then rewrites the IDs file exactly once
+    Public Virtual Void DeleteAllById(const StdVector<ID>& ids) override {
+        if (writeBatching) {
+            // Batching mode already coalesces the IDs commit; buffer each delete
+            for (const auto& id : ids) {
+                DeleteById(id);
+            }
+            return;
+        }
+
+        StdVector<ID> removedIds;
+
+        for (const auto& id : ids) {
+#ifndef ARDUINO
+            // Exclusive stripe lock for this ID while deleting
+            MaybeUniqueLock stripeGuard(EntityStripe(id), threadSafe);
+#endif
+            if (!ExistsByIdUnlocked(id)) {
+                continue;
+            }
+
+            // Delete file using file manager
+            StdString filePath = GetFilePath(id);
+            fileManager->Delete(filePath);
+
+            // Drop the cached entity, if any
+            EntityCacheErase(id);
+            ChecksumErase(id);
+            SnapshotInvalidate(id);
+
+            // Keep registered secondary indexes coherent
+            UpdateIndexesOnDelete(id);
+
+            // Remove from the in-memory index; file commit happens once below
+            IdIndexRemove(id);
+            removedIds.push_back(id);
+        }
+
+        // Commit the IDs file exactly once for the whole batch
+        if (!removedIds.empty()) {
+            RemoveIdsFromFile(removedIds);
+        }
+    }
+
+    // Delete: Delete an entity
+    Public Virtual Void Delete(Entity& entity) override {
+        // Get ID from entity
+        optional<ID> id = entity.GetPrimaryKey();
+        
+        if(id.has_value()) {
+            // Use DeleteById to delete
+            DeleteById(id.value());
+        }
+    }
+
+    // Check if entity exists by ID
     Public Virtual Bool ExistsById(ID id) override {
+#ifndef ARDUINO
+        // Shared stripe lock: lookups on different IDs run fully parallel
+        MaybeSharedLock stripeGuard(EntityStripe(id), threadSafe);
+#endif
+        return ExistsByIdUnlocked(id);
+    }
+
+    // Helper method implementing ExistsById without taking the stripe lock
+    // Used by callers that already hold the stripe exclusively
+    Protected Bool ExistsByIdUnlocked(ID id) {
+        // Batched state not yet on disk must stay visible to readers
+        if (writeBatching) {
+#ifndef ARDUINO
+            MaybeMutexLock batchGuard(batchMutex, threadSafe);
+#endif
+            if (pendingDeletes.count(id) > 0) {
+                return false;
+            }
+            if (pendingWrites.count(id) > 0) {
+                return true;
+            }
+        }
+
         // Check if the entity file exists (more reliable than checking IDs file)
         StdString filePath = GetFilePath(id);
-        CStdString filePathRef = filePath;
-        StdString contents = fileManager->Read(filePathRef);
+        StdString contents = fileManager->Read(filePath);
         return !contents.empty();
     }
 };
@@ -0,0 +1,320 @@
+#ifndef _CPA_REPOSITORY_STATIC_H_
+#define _CPA_REPOSITORY_STATIC_H_
+
+#include "CompileTimeHash.h"
+#include <StandardDefines.h>
+#include <optional>
+#include <type_traits>
+#include <functional>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <unordered_set>
+
+#ifdef ARDUINO
+#define STATIC_DATABASE_PATH ""
+#else
+#define STATIC_DATABASE_PATH "/Users/nkurude/db/"
+#endif
+
+// Statically-dispatched repository variant with zero virtual calls
+//
+// CpaRepositoryImpl routes every operation through two virtual layers (the
+// CpaRepository interface and IFileManager), which blocks inlining of the
+// small hot helpers and costs measurable cycles on ESP32. Here the file
+// manager is a template parameter held by value, so the whole FindById/Save
+// path compiles into one flat function. FileManager must provide the same
+// Create/Read/Update/Delete/Append methods as IFileManager but needs no
+// virtual interface.
+//
+// This variant keeps the lean core: CRUD, the in-memory ID index, Count and
+// ForEach. DI users and features like caching, batching and secondary
+// indexes stay on the virtual CpaRepositoryImpl; performance-critical
+// repositories opt into this one.
+template<typename Entity, typename ID, typename FileManager>
+class CpaRepositoryStatic {
+    Public FileManager fileManager;
+
+    // Private template function to convert ID to string
+    Private template<typename T>
+    StdString ConvertToString(const T& value) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, StdString>) {
+            return value;
+        } else {
+            return StdString(std::to_string(value).c_str());
+        }
+    }
+
+    // Private template function to convert string to ID type
+    Private template<typename T>
+    T ConvertFromString(const StdString& str) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, StdString>) {
+            return str;
+        } else if constexpr (std::is_same_v<T, int>) {
+            return std::stoi(str.c_str());
+        } else if constexpr (std::is_same_v<T, long>) {
+            return std::stol(str.c_str());
+        } else if constexpr (std::is_same_v<T, long long>) {
+            return std::stoll(str.c_str());
+        } else if constexpr (std::is_same_v<T, float>) {
+            return std::stof(str.c_str());
+        } else if constexpr (std::is_same_v<T, double>) {
+            return std::stod(str.c_str());
+        } else {
+            return static_cast<T>(std::stoll(str.c_str()));
+        }
+    }
+
+    // Helper method to generate consistent hash for a string input
+    // Same FNV-1a scheme as CpaRepositoryImpl, so both variants resolve the
+    // same file names and can share a table
+    Protected Static StdString GenerateHash(CStdString& input) {
+        uint32_t hash32 = Fnv1a32(input.c_str(), input.length());
+        return StdString(std::to_string(hash32).c_str());
+    }
+
+    // Cached path pieces (see CpaRepositoryImpl): computed once per instance
+    Private StdString cachedNamePrefix;
+    Private StdString cachedIdsFilePath;
+    Private StdString pathScratch;
+
+    Protected CStdString& GetNamePrefix() {
+        if (cachedNamePrefix.empty()) {
+            StdString tableName = Entity::GetTableName();
+            StdString primaryKeyName = Entity::GetPrimaryKeyName();
+            cachedNamePrefix = tableName + "_" + primaryKeyName + "_";
+        }
+        return cachedNamePrefix;
+    }
+
+    Protected StdString GetIdsFilePath() {
+        if (cachedIdsFilePath.empty()) {
+            StdString tableName = Entity::GetTableName();
+            cachedIdsFilePath = StdString(STATIC_DATABASE_PATH) + GenerateHash(tableName + "_IDs");
+        }
+        return cachedIdsFilePath;
+    }
+
+    // Helper method to append an ID without heap allocation for integrals
+    Protected Void AppendIdToBuffer(StdString& out, const ID& id) {
+        if constexpr (std::is_same_v<ID, std::string> || std::is_same_v<ID, StdString>) {
+            out += id;
+        } else if constexpr (std::is_integral_v<ID>) {
+            char buffer[24];
+            if constexpr (std::is_signed_v<ID>) {
+                snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(id));
+            } else {
+                snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(id));
+            }
+            out += buffer;
+        } else {
+            out += ConvertToString(id);
+        }
+    }
+
+    // Helper method to construct file path
+    Protected StdString GetFilePath(ID id) {
+        pathScratch.clear();
+        pathScratch += GetNamePrefix();
+        AppendIdToBuffer(pathScratch, id);
+        return StdString(STATIC_DATABASE_PATH) + GenerateHash(pathScratch);
+    }
+
+    // In-memory ID index, lazily loaded from the IDs file once
+    Private Bool idIndexLoaded = false;
+    Private StdVector<ID> idList;
+    Private std::unordered_set<ID> idSet;
+
+    // Helper method to read all IDs from the IDs file (one ID per line)
+    Protected StdVector<ID> ReadAllIds() {
+        StdVector<ID> ids;
+        StdString idsFilePath = GetIdsFilePath();
+        StdString contents = fileManager.Read(idsFilePath);
+
+        StdString currentId;
+        for (size_t i = 0; i <= contents.length(); i++) {
+            if (i == contents.length() || contents[i] == '\n' || contents[i] == '\r') {
+                if (!currentId.empty()) {
+                    ids.push_back(ConvertFromString<ID>(currentId));
+                    currentId.clear();
+                }
+            } else {
+                currentId += contents[i];
+            }
+        }
+        return ids;
+    }
+
+    // Helper method to write all IDs to the IDs file
+    Protected Void WriteAllIds(const StdVector<ID>& ids) {
+        StdString idsFilePath = GetIdsFilePath();
+        StdString contents;
+        for (size_t i = 0; i < ids.size(); i++) {
+            contents += ConvertToString(ids[i]);
+            contents += StdString("\n");
+        }
+        fileManager.Create(idsFilePath, contents);
+    }
+
+    Protected Void EnsureIdIndexLoaded() {
+        if (idIndexLoaded) {
+            return;
+        }
+        idList = ReadAllIds();
+        idSet.clear();
+        for (const auto& id : idList) {
+            idSet.insert(id);
+        }
+        idIndexLoaded = true;
+    }
+
+    // Create: Save a new entity
+    Public Entity Save(Entity& entity) {
+        optional<ID> generatedId = entity.GetPrimaryKey();
+
+        if (generatedId.has_value()) {
+            ID id = generatedId.value();
+
+            StdString filePath = GetFilePath(id);
+            StdString contents = entity.Serialize();
+            fileManager.Create(filePath, contents);
+
+            EnsureIdIndexLoaded();
+            if (idSet.insert(id).second) {
+                idList.push_back(id);
+                StdString idsFilePath = GetIdsFilePath();
+                StdString idStr = ConvertToString(id) + StdString("\n");
+                fileManager.Append(idsFilePath, idStr);
+            }
+        }
+
+        return entity;
+    }
+
+    // Create: Save a new entity passed as an rvalue; moves it back out
+    Public Entity Save(Entity&& entity) {
+        Save(entity);
+        return std::move(entity);
+    }
+
+    // Read: Find entity by ID
+    Public optional<Entity> FindById(ID id) {
+        StdString filePath = GetFilePath(id);
+        StdString contents = fileManager.Read(filePath);
+
+        if (contents.empty()) {
+            return std::nullopt;
+        }
+
+        Entity entity = Entity::Deserialize(contents);
+        return entity;
+    }
+
+    // Read: Find all entities
+    Public StdVector<Entity> FindAll() {
+        StdVector<Entity> entities;
+        EnsureIdIndexLoaded();
+        entities.reserve(idList.size());
+
+        for (const auto& id : idList) {
+            StdString filePath = GetFilePath(id);
+            StdString contents = fileManager.Read(filePath);
+            if (!contents.empty()) {
+                entities.emplace_back(Entity::Deserialize(contents));
+            }
+        }
+
+        return entities;
+    }
+
+    // Read: Stream all entities through a callback; returning false stops
+    Public Void ForEach(std::function<Bool(Entity&)> callback) {
+        EnsureIdIndexLoaded();
+
+        StdString filePath;
+        StdString contents;
+        for (const auto& id : idList) {
+            filePath = GetFilePath(id);
+            contents = fileManager.Read(filePath);
+            if (!contents.empty()) {
+                Entity entity = Entity::Deserialize(contents);
+                if (!callback(entity)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // Count: Number of entities in the table
+    Public size_t Count() {
+        EnsureIdIndexLoaded();
+        return idList.size();
+    }
+
+    // Update: Update an existing entity
+    Public Entity Update(Entity& entity) {
+        optional<ID> id = entity.GetPrimaryKey();
+
+        if (id.has_value()) {
+            ID entityId = id.value();
+
+            StdString filePath = GetFilePath(entityId);
+            StdString contents = entity.Serialize();
+            fileManager.Update(filePath, contents);
+
+            EnsureIdIndexLoaded();
+            if (idSet.insert(entityId).second) {
+                idList.push_back(entityId);
+                StdString idsFilePath = GetIdsFilePath();
+                StdString idStr = ConvertToString(entityId) + StdString("\n");
+                fileManager.Append(idsFilePath, idStr);
+            }
+        }
+
+        return entity;
+    }
+
+    // Update: Update an existing entity passed as an rvalue; moves it back out
+    Public Entity Update(Entity&& entity) {
+        Update(entity);
+        return std::move(entity);
+    }
+
+    // Delete: Delete entity by ID
+    Public Void DeleteById(ID id) {
+        if (!ExistsById(id)) {
+            return;
+        }
+
+        StdString filePath = GetFilePath(id);
+        fileManager.Delete(filePath);
+
+        EnsureIdIndexLoaded();
+        if (idSet.erase(id) > 0) {
+            for (size_t i = 0; i < idList.size(); i++) {
+                if (idList[i] == id) {
+                    idList.erase(idList.begin() + i);
+                    break;
+                }
+            }
+        }
+        WriteAllIds(idList);
+    }
+
+    // Delete: Delete an entity
+    Public Void Delete(Entity& entity) {
+        optional<ID> id = entity.GetPrimaryKey();
+        if (id.has_value()) {
+            DeleteById(id.value());
+        }
+    }
+
+    // Check if entity exists by ID
+    Public Bool ExistsById(ID id) {
+        StdString filePath = GetFilePath(id);
+        StdString contents = fileManager.Read(filePath);
+        return !contents.empty();
+    }
+};
+
+#endif // _CPA_REPOSITORY_STATIC_H_
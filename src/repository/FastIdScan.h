@@ -0,0 +1,106 @@
+#ifndef _FAST_ID_SCAN_H_
+#define _FAST_ID_SCAN_H_
+
+#include <StandardDefines.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Bulk line splitting and branch-light integer parsing for the ID-index
+// load path. ReadAllIds previously walked the IDs file one character at a
+// time and parsed every line through std::stoi and friends, whose locale
+// and exception machinery dominates a large load; these helpers scan 16
+// bytes per step where the ISA allows it (SSE2 on desktop, NEON on 64-bit ARM,
+// a plain scalar loop on AVR/ESP32) and parse digits with a single
+// unsigned range check per byte.
+
+// FindLineBreak: Index of the first '\n' or '\r' in data[offset, length),
+// or length when the remainder holds none
+inline size_t FindLineBreak(const char* data, size_t offset, size_t length) {
+#if defined(__SSE2__)
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    while (offset + 16 <= length) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+        __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(block, newline),
+                                       _mm_cmpeq_epi8(block, carriageReturn));
+        int mask = _mm_movemask_epi8(matches);
+        if (mask != 0) {
+            return offset + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+        offset += 16;
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint8x16_t newline = vdupq_n_u8('\n');
+    const uint8x16_t carriageReturn = vdupq_n_u8('\r');
+    while (offset + 16 <= length) {
+        uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + offset));
+        uint8x16_t matches = vorrq_u8(vceqq_u8(block, newline),
+                                      vceqq_u8(block, carriageReturn));
+        // Cheapest NEON "any lane set" check: max across the vector
+        if (vmaxvq_u8(matches) != 0) {
+            // A match is within these 16 bytes; find it with the scalar tail
+            break;
+        }
+        offset += 16;
+    }
+#endif
+    // Scalar path: the whole loop on AVR/ESP32, the sub-16-byte tail elsewhere
+    while (offset < length) {
+        char c = data[offset];
+        if (c == '\n' || c == '\r') {
+            return offset;
+        }
+        offset++;
+    }
+    return length;
+}
+
+// ParseIntegral: Parse a decimal integer from data[begin, end) without
+// locale lookups or exceptions. A single unsigned subtraction doubles as
+// the digit range check. Returns false on an empty span, a stray
+// character or overflow so the caller can fall back to the general
+// conversion path (which reports the malformed line the usual way).
+template<typename T>
+inline Bool ParseIntegral(const char* data, size_t begin, size_t end, T& out) {
+    static_assert(std::is_integral<T>::value, "ParseIntegral requires an integral type");
+
+    Bool negative = false;
+    if (begin < end && (data[begin] == '-' || data[begin] == '+')) {
+        negative = (data[begin] == '-');
+        begin++;
+    }
+    if (begin >= end || (negative && !std::is_signed<T>::value)) {
+        return false;
+    }
+
+    // Accumulate in the unsigned counterpart so signed overflow stays defined
+    using Unsigned = typename std::make_unsigned<T>::type;
+    constexpr Unsigned signedMax = static_cast<Unsigned>(std::is_signed<T>::value
+        ? static_cast<Unsigned>(~Unsigned(0)) >> 1
+        : ~Unsigned(0));
+    const Unsigned limit = negative ? signedMax + 1 : signedMax;
+
+    Unsigned value = 0;
+    for (size_t i = begin; i < end; i++) {
+        unsigned digit = static_cast<unsigned char>(data[i]) - static_cast<unsigned>('0');
+        if (digit > 9) {
+            return false;
+        }
+        if (value > (limit - digit) / 10) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+
+    out = negative ? static_cast<T>(Unsigned(0) - value) : static_cast<T>(value);
+    return true;
+}
+
+#endif // _FAST_ID_SCAN_H_
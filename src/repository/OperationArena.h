@@ -0,0 +1,121 @@
+#ifndef _OPERATION_ARENA_H_
+#define _OPERATION_ARENA_H_
+
+#include <StandardDefines.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+// Bump-pointer arena for short-lived per-operation temporaries
+//
+// Allocation is a pointer increment into a chunk; nothing is freed
+// individually. Reset() rewinds to the start while keeping every chunk, so
+// a long-running loop (a scan deserializing 100k entities, a device that
+// syncs every few seconds) reaches a steady state where repository-side
+// temporaries cause no heap traffic at all - the allocation pattern that
+// fragments the ESP32 heap over weeks of uptime.
+//
+// StdString itself is serializationlib's typedef and the Entity/IFileManager
+// interfaces are fixed to it, so the repository cannot re-plumb its string
+// type; CpaRepositoryImpl instead recycles StdString capacity via reused
+// buffers and IFileManager::ReadInto. Entity implementations can use
+// ArenaString and ArenaVector for their own Deserialize temporaries.
+class OperationArena {
+    Private Static constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+
+    Private struct Chunk {
+        char* data;
+        size_t size;
+    };
+    Private std::vector<Chunk> chunks;
+    Private size_t currentChunk = 0;
+    Private size_t currentOffset = 0;
+    Private size_t chunkSize;
+
+    Public explicit OperationArena(size_t chunkSizeIn = DEFAULT_CHUNK_SIZE)
+        : chunkSize(chunkSizeIn) {}
+
+    Public ~OperationArena() {
+        for (auto& chunk : chunks) {
+            delete[] chunk.data;
+        }
+    }
+
+    // Arenas own raw memory and are not copyable
+    Public OperationArena(const OperationArena&) = delete;
+    Public OperationArena& operator=(const OperationArena&) = delete;
+
+    // Allocate size bytes with the given alignment (a pointer bump)
+    Public Void* Allocate(size_t size, size_t alignment) {
+        while (currentChunk < chunks.size()) {
+            size_t aligned = (currentOffset + alignment - 1) & ~(alignment - 1);
+            if (aligned + size <= chunks[currentChunk].size) {
+                currentOffset = aligned + size;
+                return chunks[currentChunk].data + aligned;
+            }
+            currentChunk++;
+            currentOffset = 0;
+        }
+
+        // Need a fresh chunk; oversized requests get a dedicated one
+        size_t newSize = size > chunkSize ? size : chunkSize;
+        chunks.push_back(Chunk{new char[newSize], newSize});
+        currentChunk = chunks.size() - 1;
+        currentOffset = size;
+        return chunks[currentChunk].data;
+    }
+
+    // Rewind to the start, keeping every chunk for reuse
+    Public Void Reset() {
+        currentChunk = 0;
+        currentOffset = 0;
+    }
+
+    // Total bytes held across all chunks (for telemetry / tuning)
+    Public size_t Capacity() const {
+        size_t total = 0;
+        for (const auto& chunk : chunks) {
+            total += chunk.size;
+        }
+        return total;
+    }
+};
+
+// Standard-allocator adapter over an OperationArena
+// deallocate is a no-op; memory is reclaimed by OperationArena::Reset, so
+// containers using this allocator must not outlive the next Reset
+template<typename T>
+class ArenaAllocator {
+    Public using value_type = T;
+
+    Public OperationArena* arena;
+
+    Public explicit ArenaAllocator(OperationArena& arenaIn) : arena(&arenaIn) {}
+
+    Public template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    Public T* allocate(size_t count) {
+        return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    Public Void deallocate(T*, size_t) {
+        // Individual frees are no-ops; Reset() reclaims the whole arena
+    }
+
+    Public Bool operator==(const ArenaAllocator& other) const {
+        return arena == other.arena;
+    }
+
+    Public Bool operator!=(const ArenaAllocator& other) const {
+        return arena != other.arena;
+    }
+};
+
+// Arena-backed string and vector for per-operation temporaries
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // _OPERATION_ARENA_H_
@@ -0,0 +1,560 @@
+#ifndef _SEGMENT_REPOSITORY_IMPL_H_
+#define _SEGMENT_REPOSITORY_IMPL_H_
+
+#include "../CpaRepository.h"
+#include "../IFileManager.h"
+#include "CompileTimeHash.h"
+#include <optional>
+#include <type_traits>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <algorithm>
+
+#ifdef ARDUINO
+#define SEGMENT_DATABASE_PATH ""
+#else
+#define SEGMENT_DATABASE_PATH "/Users/nkurude/db/"
+#endif
+
+// Append-only single-file storage engine implementing CpaRepository
+//
+// Alternative backend to the file-per-entity CpaRepositoryImpl: all entities
+// of a table live in one segment file and every Save/Update/Delete is a
+// single append, so writes avoid the per-entity open/write/close cost and
+// flash wear on ESP32, and full scans are one sequential read.
+//
+// Segment record layout:
+//   [1 byte live flag][4 bytes LE id length][id bytes]
+//   [4 bytes LE payload length][payload bytes]
+// The latest record for an ID wins; a record with live flag 0 is a delete
+// tombstone. An in-memory offset index (ID -> payload offset/length) is
+// built by one sequential scan on first use, and the segment is compacted
+// in place once dead records pass a configurable threshold.
+template<typename Entity, typename ID>
+class SegmentRepositoryImpl : public CpaRepository<Entity, ID> {
+    Public Virtual ~SegmentRepositoryImpl() = default;
+
+    // Keep the interface's rvalue Save/Update overloads visible alongside
+    // the lvalue overrides below
+    Public using CpaRepository<Entity, ID>::Save;
+    Public using CpaRepository<Entity, ID>::Update;
+
+    /* @Autowired */
+    IFileManagerPtr fileManager;
+
+    // Private template function to convert ID to string
+    // Handles both string types and primitive types
+    Private template<typename T>
+    StdString ConvertToString(const T& value) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, StdString>) {
+            return value;
+        } else {
+            return StdString(std::to_string(value).c_str());
+        }
+    }
+
+    // Helper method to generate consistent hash for a string input
+    // Returns a hash value as StdString (guaranteed to be <= 14 characters)
+    // Uses constexpr FNV-1a (CompileTimeHash.h) so names match across platforms
+    Protected Static StdString GenerateHash(CStdString input) {
+        uint32_t hash32 = Fnv1a32(input.c_str(), input.length());
+        return StdString(std::to_string(hash32).c_str());
+    }
+
+    // Runtime storage root, defaulting to the SEGMENT_DATABASE_PATH macro
+    Private StdString databaseRoot = SEGMENT_DATABASE_PATH;
+
+    // Point this repository at a different storage root. Must not be called
+    // while operations are in flight; an existing segment file under the
+    // previous root is not moved
+    Public Void SetDatabaseRoot(CStdString& root) {
+        databaseRoot = root;
+        if (!databaseRoot.empty() && databaseRoot[databaseRoot.length() - 1] != '/') {
+            databaseRoot += '/';
+        }
+        // Any cached mapping belongs to the old root's segment file
+        segmentMapping = nullptr;
+        indexLoaded = false;
+    }
+
+    // Helper method to get the segment file path for this table
+    Protected StdString GetSegmentFilePath() {
+        StdString tableName = Entity::GetTableName();
+        return databaseRoot + GenerateHash(tableName + "_Segment");
+    }
+
+    // In-memory offset index over the segment file
+    // liveOffsets maps each live ID to its latest payload slice; idList keeps
+    // insertion order for FindAll/ForEach; deadRecords counts superseded and
+    // tombstoned records to drive compaction
+    Private struct PayloadSlice {
+        size_t offset;
+        size_t length;
+    };
+    Private Bool indexLoaded = false;
+    Private std::unordered_map<ID, PayloadSlice> liveOffsets;
+    Private StdVector<ID> idList;
+    Private size_t deadRecords = 0;
+    Private FileMappingPtr segmentMapping;
+    // Logical end of the segment file. The cached mapping goes stale the
+    // moment a record is appended, so offsets for new records come from
+    // this counter, advanced by every append, never from the mapping
+    Private size_t segmentEnd = 0;
+
+    // Dead records tolerated before Save/Delete triggers a compaction
+    // 0 disables automatic compaction (Compact() stays available)
+    Private size_t compactionThreshold = 1024;
+
+    // Configure how many dead records accumulate before auto-compaction
+    Public Void SetCompactionThreshold(size_t threshold) {
+        compactionThreshold = threshold;
+    }
+
+    // Helper method to encode one segment record
+    Protected Void EncodeRecord(StdString& out, ID id, CStdString& payload, Bool live) {
+        out += static_cast<char>(live ? 1 : 0);
+        StdString idStr = ConvertToString(id);
+        uint32_t idLength = static_cast<uint32_t>(idStr.length());
+        for (int shift = 0; shift < 32; shift += 8) {
+            out += static_cast<char>((idLength >> shift) & 0xFF);
+        }
+        out.append(idStr.c_str(), idStr.length());
+        uint32_t payloadLength = static_cast<uint32_t>(payload.length());
+        for (int shift = 0; shift < 32; shift += 8) {
+            out += static_cast<char>((payloadLength >> shift) & 0xFF);
+        }
+        out.append(payload.c_str(), payload.length());
+    }
+
+    // Helper method to convert the stored ID string back to the ID type
+    Private template<typename T>
+    T ConvertFromString(const StdString& str) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, StdString>) {
+            return str;
+        } else if constexpr (std::is_same_v<T, int>) {
+            return std::stoi(str.c_str());
+        } else if constexpr (std::is_same_v<T, long>) {
+            return std::stol(str.c_str());
+        } else if constexpr (std::is_same_v<T, long long>) {
+            return std::stoll(str.c_str());
+        } else if constexpr (std::is_same_v<T, float>) {
+            return std::stof(str.c_str());
+        } else if constexpr (std::is_same_v<T, double>) {
+            return std::stod(str.c_str());
+        } else {
+            return static_cast<T>(std::stoll(str.c_str()));
+        }
+    }
+
+    // Helper method to read a 4-byte little-endian length at offset
+    Private Static Bool ReadLength(const char* data, size_t length, size_t& offset, uint32_t& value) {
+        if (offset + 4 > length) {
+            return false;
+        }
+        value = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            value |= static_cast<uint32_t>(static_cast<unsigned char>(data[offset])) << shift;
+            offset++;
+        }
+        return true;
+    }
+
+    // Helper method to (re)map the segment file and rebuild the offset index
+    // One sequential scan; the latest record per ID wins
+    Protected Void RebuildIndex() {
+        liveOffsets.clear();
+        idList.clear();
+        deadRecords = 0;
+
+        StdString segmentPath = GetSegmentFilePath();
+        CStdString segmentPathRef = segmentPath;
+        segmentMapping = fileManager->ReadMapped(segmentPathRef);
+
+        segmentEnd = segmentMapping ? segmentMapping->Length() : 0;
+
+        if (segmentMapping && !segmentMapping->Empty()) {
+            const char* data = segmentMapping->Data();
+            size_t length = segmentMapping->Length();
+            size_t offset = 0;
+
+            while (offset < length) {
+                Bool live = (data[offset] != 0);
+                offset++;
+
+                uint32_t idLength;
+                if (!ReadLength(data, length, offset, idLength) || offset + idLength > length) {
+                    break; // truncated tail (partial append); ignore it
+                }
+                StdString idStr(data + offset, idLength);
+                offset += idLength;
+
+                uint32_t payloadLength;
+                if (!ReadLength(data, length, offset, payloadLength) || offset + payloadLength > length) {
+                    break;
+                }
+
+                ID id = ConvertFromString<ID>(idStr);
+                auto found = liveOffsets.find(id);
+                if (live) {
+                    if (found == liveOffsets.end()) {
+                        idList.push_back(id);
+                    } else {
+                        deadRecords++; // superseded older record
+                    }
+                    liveOffsets[id] = PayloadSlice{offset, payloadLength};
+                } else {
+                    if (found != liveOffsets.end()) {
+                        liveOffsets.erase(found);
+                        for (size_t i = 0; i < idList.size(); i++) {
+                            if (idList[i] == id) {
+                                idList.erase(idList.begin() + i);
+                                break;
+                            }
+                        }
+                        deadRecords++;
+                    }
+                    deadRecords++; // the tombstone itself
+                }
+
+                offset += payloadLength;
+            }
+        }
+
+        indexLoaded = true;
+    }
+
+    // Helper method to lazily build the offset index on first use
+    Protected Void EnsureIndexLoaded() {
+        if (!indexLoaded) {
+            RebuildIndex();
+        }
+    }
+
+    // Helper method to fetch a payload slice out of the segment mapping
+    // Remaps the file when the slice lies past the cached mapping (appended
+    // after the last map)
+    Protected optional<StdString> ReadPayload(const PayloadSlice& slice) {
+        if (!segmentMapping || slice.offset + slice.length > segmentMapping->Length()) {
+            StdString segmentPath = GetSegmentFilePath();
+            CStdString segmentPathRef = segmentPath;
+            segmentMapping = fileManager->ReadMapped(segmentPathRef);
+            if (!segmentMapping || slice.offset + slice.length > segmentMapping->Length()) {
+                return std::nullopt;
+            }
+        }
+        return StdString(segmentMapping->Data() + slice.offset, slice.length);
+    }
+
+    // Helper method to append one record and update the index
+    Protected Void AppendRecord(ID id, CStdString& payload, Bool live) {
+        EnsureIndexLoaded();
+
+        StdString record;
+        EncodeRecord(record, id, payload, live);
+
+        StdString segmentPath = GetSegmentFilePath();
+        CStdString segmentPathRef = segmentPath;
+        CStdString recordRef = record;
+
+        // The payload begins after the flag byte, both length prefixes and the ID
+        size_t recordOffset = segmentEnd;
+        size_t headerLength = 1 + 4 + ConvertToString(id).length() + 4;
+
+        fileManager->Append(segmentPathRef, recordRef);
+        segmentEnd += record.length();
+
+        auto found = liveOffsets.find(id);
+        if (live) {
+            if (found == liveOffsets.end()) {
+                idList.push_back(id);
+            } else {
+                deadRecords++;
+            }
+            liveOffsets[id] = PayloadSlice{recordOffset + headerLength, payload.length()};
+        } else if (found != liveOffsets.end()) {
+            liveOffsets.erase(found);
+            for (size_t i = 0; i < idList.size(); i++) {
+                if (idList[i] == id) {
+                    idList.erase(idList.begin() + i);
+                    break;
+                }
+            }
+            deadRecords += 2; // the superseded record and the tombstone
+        }
+
+        // The cached mapping no longer covers the tail we just appended;
+        // ReadPayload remaps on demand
+        if (deadRecords > 0 && compactionThreshold > 0 && deadRecords >= compactionThreshold) {
+            Compact();
+        }
+    }
+
+    // Rewrite the segment keeping only the latest live record per ID
+    // Reclaims space held by superseded records and tombstones
+    Public Void Compact() {
+        EnsureIndexLoaded();
+
+        StdString compacted;
+        for (const auto& id : idList) {
+            auto found = liveOffsets.find(id);
+            if (found == liveOffsets.end()) {
+                continue;
+            }
+            optional<StdString> payload = ReadPayload(found->second);
+            if (payload.has_value()) {
+                CStdString payloadRef = payload.value();
+                EncodeRecord(compacted, id, payloadRef, true);
+            }
+        }
+
+        StdString segmentPath = GetSegmentFilePath();
+        CStdString segmentPathRef = segmentPath;
+        CStdString compactedRef = compacted;
+        fileManager->Create(segmentPathRef, compactedRef);
+
+        RebuildIndex();
+    }
+
+    // Create: Save a new entity (one segment append)
+    Public Virtual Entity Save(Entity& entity) override {
+        optional<ID> generatedId = entity.GetPrimaryKey();
+
+        if (generatedId.has_value()) {
+            StdString contents = entity.Serialize();
+            CStdString contentsRef = contents;
+            AppendRecord(generatedId.value(), contentsRef, true);
+        }
+
+        return entity;
+    }
+
+    // Create: Save a batch of entities as one coalesced segment append
+    // Every record is encoded into one buffer and written with a single
+    // Append, so the batch costs one file operation instead of one per
+    // entity; the compaction check runs once after the batch
+    Public Virtual StdVector<Entity> SaveAll(StdVector<Entity>& entities) override {
+        EnsureIndexLoaded();
+
+        StdString records;
+        for (auto& entity : entities) {
+            optional<ID> generatedId = entity.GetPrimaryKey();
+            if (!generatedId.has_value()) {
+                continue;
+            }
+            ID id = generatedId.value();
+            StdString contents = entity.Serialize();
+            CStdString contentsRef = contents;
+
+            // The payload begins after the flag byte, both length prefixes
+            // and the ID; earlier records in this batch sit before it
+            size_t recordOffset = segmentEnd + records.length();
+            size_t headerLength = 1 + 4 + ConvertToString(id).length() + 4;
+            EncodeRecord(records, id, contentsRef, true);
+
+            auto found = liveOffsets.find(id);
+            if (found == liveOffsets.end()) {
+                idList.push_back(id);
+            } else {
+                deadRecords++;
+            }
+            liveOffsets[id] = PayloadSlice{recordOffset + headerLength, contents.length()};
+        }
+
+        if (!records.empty()) {
+            StdString segmentPath = GetSegmentFilePath();
+            CStdString segmentPathRef = segmentPath;
+            CStdString recordsRef = records;
+            fileManager->Append(segmentPathRef, recordsRef);
+            segmentEnd += records.length();
+        }
+
+        if (deadRecords > 0 && compactionThreshold > 0 && deadRecords >= compactionThreshold) {
+            Compact();
+        }
+
+        return entities;
+    }
+
+    // Read: Find entity by ID via the in-memory offset index
+    Public Virtual optional<Entity> FindById(ID id) override {
+        EnsureIndexLoaded();
+
+        auto found = liveOffsets.find(id);
+        if (found == liveOffsets.end()) {
+            return std::nullopt;
+        }
+
+        optional<StdString> payload = ReadPayload(found->second);
+        if (!payload.has_value() || payload.value().empty()) {
+            return std::nullopt;
+        }
+
+        Entity entity = Entity::Deserialize(payload.value());
+        return entity;
+    }
+
+    // Read: Find all entities with one sequential pass over the segment
+    Public Virtual StdVector<Entity> FindAll() override {
+        StdVector<Entity> entities;
+        EnsureIndexLoaded();
+
+        for (const auto& id : idList) {
+            optional<Entity> entity = FindById(id);
+            if (entity.has_value()) {
+                entities.push_back(entity.value());
+            }
+        }
+
+        return entities;
+    }
+
+    // Read: Find one page of entities (pageNumber is zero-based)
+    Public Virtual StdVector<Entity> FindAll(size_t pageNumber, size_t pageSize) override {
+        StdVector<Entity> entities;
+        EnsureIndexLoaded();
+
+        if (pageSize == 0) {
+            return entities;
+        }
+
+        size_t offset = pageNumber * pageSize;
+        if (offset >= idList.size()) {
+            return entities;
+        }
+
+        size_t end = offset + pageSize;
+        if (end > idList.size()) {
+            end = idList.size();
+        }
+
+        for (size_t i = offset; i < end; i++) {
+            optional<Entity> entity = FindById(idList[i]);
+            if (entity.has_value()) {
+                entities.push_back(entity.value());
+            }
+        }
+
+        return entities;
+    }
+
+    // Read: Find all entities ordered by primary key
+    Public Virtual StdVector<Entity> FindAllSorted(Bool ascending) override {
+        EnsureIndexLoaded();
+
+        StdVector<ID> ids = idList;
+        if (ascending) {
+            std::sort(ids.begin(), ids.end());
+        } else {
+            std::sort(ids.begin(), ids.end(), std::greater<ID>());
+        }
+
+        StdVector<Entity> entities;
+        entities.reserve(ids.size());
+        for (const auto& id : ids) {
+            optional<Entity> entity = FindById(id);
+            if (entity.has_value()) {
+                entities.push_back(std::move(entity.value()));
+            }
+        }
+        return entities;
+    }
+
+    // Read: Find the first K entities in primary-key order
+    // Only the first K IDs are placed (partial_sort) and deserialized
+    Public Virtual StdVector<Entity> FindTopK(size_t k, Bool ascending) override {
+        StdVector<Entity> entities;
+        if (k == 0) {
+            return entities;
+        }
+        EnsureIndexLoaded();
+
+        StdVector<ID> ids = idList;
+        if (k < ids.size()) {
+            if (ascending) {
+                std::partial_sort(ids.begin(), ids.begin() + k, ids.end());
+            } else {
+                std::partial_sort(ids.begin(), ids.begin() + k, ids.end(), std::greater<ID>());
+            }
+            ids.resize(k);
+        } else {
+            if (ascending) {
+                std::sort(ids.begin(), ids.end());
+            } else {
+                std::sort(ids.begin(), ids.end(), std::greater<ID>());
+            }
+        }
+
+        entities.reserve(ids.size());
+        for (const auto& id : ids) {
+            optional<Entity> entity = FindById(id);
+            if (entity.has_value()) {
+                entities.push_back(std::move(entity.value()));
+            }
+        }
+        return entities;
+    }
+
+    // Count: Number of live entities in the segment
+    Public Virtual size_t Count() override {
+        EnsureIndexLoaded();
+        return idList.size();
+    }
+
+    // Read: Stream all entities one at a time through a callback
+    // The callback returns false to stop iteration early
+    Public Virtual Void ForEach(std::function<Bool(Entity&)> callback) override {
+        EnsureIndexLoaded();
+
+        for (const auto& id : idList) {
+            optional<Entity> entity = FindById(id);
+            if (entity.has_value()) {
+                if (!callback(entity.value())) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // Update: Update an existing entity (one segment append; old record dies)
+    Public Virtual Entity Update(Entity& entity) override {
+        return Save(entity);
+    }
+
+    // Delete: Delete entity by ID (one tombstone append)
+    Public Virtual Void DeleteById(ID id) override {
+        EnsureIndexLoaded();
+
+        if (liveOffsets.find(id) == liveOffsets.end()) {
+            return;
+        }
+
+        StdString empty;
+        CStdString emptyRef = empty;
+        AppendRecord(id, emptyRef, false);
+    }
+
+    // Delete: Delete a batch of entities by ID
+    Public Virtual Void DeleteAllById(const StdVector<ID>& ids) override {
+        for (const auto& id : ids) {
+            DeleteById(id);
+        }
+    }
+
+    // Delete: Delete an entity
+    Public Virtual Void Delete(Entity& entity) override {
+        optional<ID> id = entity.GetPrimaryKey();
+        if (id.has_value()) {
+            DeleteById(id.value());
+        }
+    }
+
+    // Check if entity exists by ID (O(1) index lookup, no file access)
+    Public Virtual Bool ExistsById(ID id) override {
+        EnsureIndexLoaded();
+        return liveOffsets.find(id) != liveOffsets.end();
+    }
+};
+
+#endif // _SEGMENT_REPOSITORY_IMPL_H_
@@ -0,0 +1,144 @@
+// Regression tests for the binary IDs file format (desktop only)
+// Build with -DSPRINGBOOTPLUSPLUS_DATA_BUILD_TESTS=ON and run via ctest
+#include "DesktopFileManager.h"
+#include "repository/CpaRepositoryImpl.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Minimal entity for exercising the repository
+class IdsFormatTestRecord {
+    Public int id = 0;
+    Public StdString name;
+
+    Public Static StdString GetTableName() {
+        return StdString("IdsFormatTestRecord");
+    }
+
+    Public Static StdString GetPrimaryKeyName() {
+        return StdString("id");
+    }
+
+    Public optional<int> GetPrimaryKey() {
+        return id;
+    }
+
+    Public StdString Serialize() {
+        return StdString(std::to_string(id).c_str()) + "\t" + name;
+    }
+
+    Public Static IdsFormatTestRecord Deserialize(CStdString& contents) {
+        IdsFormatTestRecord record;
+        size_t tab = contents.find('\t');
+        record.id = std::stoi(contents.substr(0, tab).c_str());
+        record.name = contents.substr(tab + 1);
+        return record;
+    }
+
+    Public Static IdsFormatTestRecord Make(int idIn, const char* nameIn) {
+        IdsFormatTestRecord record;
+        record.id = idIn;
+        record.name = nameIn;
+        return record;
+    }
+};
+
+// Writable per-run database root derived from TMPDIR (or /tmp)
+static StdString TestDatabaseRoot() {
+    const char* tmpDir = std::getenv("TMPDIR");
+    StdString root = tmpDir != nullptr ? tmpDir : "/tmp";
+    if (!root.empty() && root[root.length() - 1] != '/') {
+        root += '/';
+    }
+    root += "springbootplusplus_data_test/ids_format";
+    return root;
+}
+
+// Remove every file the previous run may have left under the test root
+static void ResetDatabaseRoot(IFileManagerPtr fileManager, CStdString& root) {
+    fileManager->EnsureDirectory(root);
+    CpaRepositoryImpl<IdsFormatTestRecord, int> repository;
+    repository.fileManager = fileManager;
+    repository.SetDatabaseRoot(root);
+    StdVector<int> ids;
+    repository.ForEach([&ids](IdsFormatTestRecord& record) {
+        ids.push_back(record.id);
+        return true;
+    });
+    repository.DeleteAllById(ids);
+}
+
+// A table emptied by deletes keeps its binary header plus tombstones; the
+// next save must not write a second header, which a fresh instance would
+// parse as a phantom record while losing the real ID
+static void TestDeleteAllThenSave() {
+    StdString root = TestDatabaseRoot();
+    auto fileManager = std::make_shared<DesktopFileManager>();
+    ResetDatabaseRoot(fileManager, root);
+
+    {
+        CpaRepositoryImpl<IdsFormatTestRecord, int> repository;
+        repository.fileManager = fileManager;
+        repository.SetDatabaseRoot(root);
+        repository.SetBinaryIdsFileFormat(true);
+
+        IdsFormatTestRecord first = IdsFormatTestRecord::Make(1, "alpha");
+        repository.Save(first);
+        repository.DeleteById(1);
+        IdsFormatTestRecord second = IdsFormatTestRecord::Make(2, "bravo");
+        repository.Save(second);
+    }
+
+    // A fresh instance parses the file from scratch
+    CpaRepositoryImpl<IdsFormatTestRecord, int> reopened;
+    reopened.fileManager = fileManager;
+    reopened.SetDatabaseRoot(root);
+    assert(reopened.Count() == 1);
+    StdVector<IdsFormatTestRecord> all = reopened.FindAll();
+    assert(all.size() == 1);
+    assert(all[0].id == 2);
+    assert(all[0].name == "bravo");
+}
+
+// Enabling the binary format over an existing text table must rewrite the
+// file exactly once and keep every ID readable afterwards
+static void TestTextToBinaryMigration() {
+    StdString root = TestDatabaseRoot();
+    auto fileManager = std::make_shared<DesktopFileManager>();
+    ResetDatabaseRoot(fileManager, root);
+
+    {
+        CpaRepositoryImpl<IdsFormatTestRecord, int> repository;
+        repository.fileManager = fileManager;
+        repository.SetDatabaseRoot(root);
+        for (int i = 1; i <= 5; i++) {
+            IdsFormatTestRecord record = IdsFormatTestRecord::Make(i, "text");
+            repository.Save(record);
+        }
+    }
+    {
+        CpaRepositoryImpl<IdsFormatTestRecord, int> repository;
+        repository.fileManager = fileManager;
+        repository.SetDatabaseRoot(root);
+        repository.SetBinaryIdsFileFormat(true);
+        IdsFormatTestRecord record = IdsFormatTestRecord::Make(6, "binary");
+        repository.Save(record);
+    }
+
+    CpaRepositoryImpl<IdsFormatTestRecord, int> reopened;
+    reopened.fileManager = fileManager;
+    reopened.SetDatabaseRoot(root);
+    assert(reopened.Count() == 6);
+    for (int i = 1; i <= 6; i++) {
+        assert(reopened.ExistsById(i));
+    }
+}
+
+int main() {
+    TestDeleteAllThenSave();
+    TestTextToBinaryMigration();
+    printf("BinaryIdsFormatTest: all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,187 @@
+// Regression tests for the segment-file storage engine (desktop only)
+// Build with -DSPRINGBOOTPLUSPLUS_DATA_BUILD_TESTS=ON and run via ctest
+#include "DesktopFileManager.h"
+#include "repository/SegmentRepositoryImpl.h"
+#include "repository/CompileTimeHash.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Minimal entity for exercising the engine
+class SegmentTestRecord {
+    Public int id = 0;
+    Public StdString name;
+
+    Public Static StdString GetTableName() {
+        return StdString("SegmentTestRecord");
+    }
+
+    Public Static StdString GetPrimaryKeyName() {
+        return StdString("id");
+    }
+
+    Public optional<int> GetPrimaryKey() {
+        return id;
+    }
+
+    Public StdString Serialize() {
+        return StdString(std::to_string(id).c_str()) + "\t" + name;
+    }
+
+    Public Static SegmentTestRecord Deserialize(CStdString& contents) {
+        SegmentTestRecord record;
+        size_t tab = contents.find('\t');
+        record.id = std::stoi(contents.substr(0, tab).c_str());
+        record.name = contents.substr(tab + 1);
+        return record;
+    }
+
+    Public Static SegmentTestRecord Make(int idIn, const char* nameIn) {
+        SegmentTestRecord record;
+        record.id = idIn;
+        record.name = nameIn;
+        return record;
+    }
+};
+
+// Writable per-run database root derived from TMPDIR (or /tmp)
+static StdString TestDatabaseRoot() {
+    const char* tmpDir = std::getenv("TMPDIR");
+    StdString root = tmpDir != nullptr ? tmpDir : "/tmp";
+    if (!root.empty() && root[root.length() - 1] != '/') {
+        root += '/';
+    }
+    root += "springbootplusplus_data_test/segment";
+    return root;
+}
+
+// Point a repository at the test root, creating it on first use
+static void UseTestRoot(SegmentRepositoryImpl<SegmentTestRecord, int>& repository) {
+    StdString root = TestDatabaseRoot();
+    repository.fileManager->EnsureDirectory(root);
+    repository.SetDatabaseRoot(root);
+}
+
+// Remove any segment file left behind by a previous run
+static void RemoveSegmentFile(IFileManagerPtr fileManager) {
+    StdString tableKey = SegmentTestRecord::GetTableName() + "_Segment";
+    StdString path = TestDatabaseRoot() + "/" +
+        StdString(std::to_string(Fnv1a32(tableKey.c_str(), tableKey.length())).c_str());
+    CStdString pathRef = path;
+    fileManager->Delete(pathRef);
+}
+
+// Consecutive saves must each record the correct payload offset; the
+// offset once came from a cached mapping that went stale after the first
+// append, so the second save's slice pointed at the first record's bytes
+static void TestConsecutiveSaves() {
+    SegmentRepositoryImpl<SegmentTestRecord, int> repository;
+    repository.fileManager = std::make_shared<DesktopFileManager>();
+    UseTestRoot(repository);
+    RemoveSegmentFile(repository.fileManager);
+
+    SegmentTestRecord first = SegmentTestRecord::Make(1, "alpha");
+    SegmentTestRecord second = SegmentTestRecord::Make(2, "bravo");
+    SegmentTestRecord third = SegmentTestRecord::Make(3, "charlie");
+    repository.Save(first);
+    repository.Save(second);
+    repository.Save(third);
+
+    optional<SegmentTestRecord> found = repository.FindById(2);
+    assert(found.has_value());
+    assert(found->id == 2);
+    assert(found->name == "bravo");
+
+    found = repository.FindById(3);
+    assert(found.has_value());
+    assert(found->name == "charlie");
+
+    // The index rebuilt from disk must agree with the in-memory one
+    SegmentRepositoryImpl<SegmentTestRecord, int> reopened;
+    reopened.fileManager = repository.fileManager;
+    UseTestRoot(reopened);
+    assert(reopened.Count() == 3);
+    found = reopened.FindById(2);
+    assert(found.has_value());
+    assert(found->name == "bravo");
+}
+
+// Updates and deletes interleaved with saves must keep offsets correct
+static void TestUpdateDeleteCompact() {
+    SegmentRepositoryImpl<SegmentTestRecord, int> repository;
+    repository.fileManager = std::make_shared<DesktopFileManager>();
+    UseTestRoot(repository);
+    RemoveSegmentFile(repository.fileManager);
+
+    for (int i = 1; i <= 10; i++) {
+        SegmentTestRecord record = SegmentTestRecord::Make(i, "initial");
+        repository.Save(record);
+    }
+
+    SegmentTestRecord updated = SegmentTestRecord::Make(5, "updated");
+    repository.Update(updated);
+    repository.DeleteById(7);
+
+    assert(repository.Count() == 9);
+    optional<SegmentTestRecord> found = repository.FindById(5);
+    assert(found.has_value());
+    assert(found->name == "updated");
+    assert(!repository.FindById(7).has_value());
+
+    // Compaction rewrites the file; offsets must stay valid afterwards
+    repository.Compact();
+    assert(repository.Count() == 9);
+    found = repository.FindById(5);
+    assert(found.has_value());
+    assert(found->name == "updated");
+
+    SegmentTestRecord late = SegmentTestRecord::Make(11, "post-compact");
+    repository.Save(late);
+    found = repository.FindById(11);
+    assert(found.has_value());
+    assert(found->name == "post-compact");
+}
+
+// SaveAll writes the batch as one append; offsets must be correct for
+// every record in the buffer, including one superseding an earlier save
+static void TestSaveAllBatch() {
+    SegmentRepositoryImpl<SegmentTestRecord, int> repository;
+    repository.fileManager = std::make_shared<DesktopFileManager>();
+    UseTestRoot(repository);
+    RemoveSegmentFile(repository.fileManager);
+
+    SegmentTestRecord early = SegmentTestRecord::Make(2, "stale");
+    repository.Save(early);
+
+    StdVector<SegmentTestRecord> batch;
+    for (int i = 1; i <= 5; i++) {
+        batch.push_back(SegmentTestRecord::Make(i, ("batch" + std::to_string(i)).c_str()));
+    }
+    repository.SaveAll(batch);
+
+    assert(repository.Count() == 5);
+    for (int i = 1; i <= 5; i++) {
+        optional<SegmentTestRecord> found = repository.FindById(i);
+        assert(found.has_value());
+        assert(found->name == "batch" + std::to_string(i));
+    }
+
+    // The index rebuilt from disk must agree with the in-memory one
+    SegmentRepositoryImpl<SegmentTestRecord, int> reopened;
+    reopened.fileManager = repository.fileManager;
+    UseTestRoot(reopened);
+    assert(reopened.Count() == 5);
+    optional<SegmentTestRecord> found = reopened.FindById(2);
+    assert(found.has_value());
+    assert(found->name == "batch2");
+}
+
+int main() {
+    TestConsecutiveSaves();
+    TestUpdateDeleteCompact();
+    TestSaveAllBatch();
+    printf("SegmentRepositoryTest: all tests passed\n");
+    return 0;
+}